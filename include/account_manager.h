@@ -3,16 +3,49 @@
 #pragma once
 
 #include "player_manager.h"
+#include "task.h"
+#include "worker_pool.h"
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace PlayerRegister {
 
 class AccountManager {
 public:
+    static void init();
+    static void shutdown();
+    static WorkerPool::Stats getHashPoolStats();
+    static WorkerPool::Stats getIoPoolStats();
+    // Hash and I/O pool lines for /authstats
+    static void describeStats(std::vector<std::string>& lines);
+    static WorkerPool* getHashPool();
+    // The one thread that reads and writes account files
+    static WorkerPool* getIoPool();
+
+    // Length of the numeric passwords handed out by /resetpassword and /resetpasswords
+    static constexpr size_t RESET_PASSWORD_DIGITS = 8;
+
+    // Account files are read and written on the I/O pool and passwords hashed
+    // on the hash pool; these return as soon as the flow has started and
+    // finish it on the main thread.
     static bool createAccount(endstone::Player& pl, const std::string& name, const std::string& password, bool create_new = false);
     static bool loginAccount(endstone::Player& pl, const std::string& name, const std::string& password);
-    static bool changePassword(const std::string& name, const std::string& new_password);
+    // done runs on the main thread with false when the account does not exist or the pools are full
+    static bool changePassword(const std::string& name, const std::string& new_password, std::function<void(bool)> done);
     static bool changePassword(endstone::Player& pl, const std::string& old_password, const std::string& new_password);
-    
+    // Removes the player's record on the I/O pool and answers on a later tick
+    static bool logout(endstone::Player& pl);
+    // Loads the account of a player whose resume ticket was redeemed and
+    // authenticates them on a later tick, or sends them to limbo if that fails.
+    // Returns false when the flow could not start.
+    static bool resumeSession(endstone::Player& pl);
+    // Revokes every resume ticket on these accounts, held online or not, and kicks online holders
+    static void endSessions(const std::unordered_set<std::string>& accounts);
+
     static void showRegisterHelp(endstone::Player& pl);
     static void showLoginHelp(endstone::Player& pl);
     static void showAccountInfo(endstone::Player& pl);
@@ -22,6 +55,42 @@ private:
     static void trimString(std::string& s);
     static bool validatePassword(const std::string& password);
     static bool validateUsername(const std::string& username);
+
+    // Guards against a player running several flows at once. The slot is
+    // released when the flow's frame goes away, on whatever thread that is.
+    static bool beginRequest(endstone::Player& pl);
+    static void endRequest(const std::string& id);
+
+    class RequestScope {
+    public:
+        explicit RequestScope(std::string id) : id_(std::move(id)) {}
+        RequestScope(const RequestScope&) = delete;
+        RequestScope& operator=(const RequestScope&) = delete;
+        ~RequestScope() { endRequest(id_); }
+
+    private:
+        std::string id_;
+    };
+
+    static PoolAwaiter onIoPool() { return onPool(ioPool_.get()); }
+    static PoolAwaiter onHashPool() { return onPool(hashPool_.get()); }
+    // Writes are never turned away by a full queue: a flow that got this far
+    // must not lose its result or write from another thread. Only fails after
+    // shutdown, and then the flow has to stop without touching the files.
+    static PoolAwaiter onIoPoolForWrite() { return onPoolUnbounded(ioPool_.get()); }
+
+    static Task createFlow(endstone::UUID uuid, PlayerManager::Handle handle, PlayerData data, std::string password);
+    static Task loginFlow(endstone::UUID uuid, PlayerManager::Handle handle, PlayerData data, std::string password);
+    static Task resetFlow(PlayerData data, std::string password, std::function<void(bool)> done);
+    static Task resumeFlow(endstone::UUID uuid, PlayerManager::Handle handle, PlayerData data);
+    static Task logoutFlow(endstone::UUID uuid, PlayerManager::Handle handle, std::string id);
+    static Task changeFlow(endstone::UUID uuid, PlayerManager::Handle handle, std::string id, Credential stored,
+                           std::string oldPassword, std::string newPassword);
+
+    static std::unique_ptr<WorkerPool> hashPool_;
+    static std::unique_ptr<WorkerPool> ioPool_; // one thread keeps writes to the same file in order
+    static std::mutex inFlightMutex_;
+    static std::unordered_set<std::string> inFlight_;
 };
 
-} // namespace PlayerRegister
\ No newline at end of file
+} // namespace PlayerRegister
@@ -0,0 +1,67 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#ifndef ARGON2_H
+#define ARGON2_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// BLAKE2b as specified in RFC 7693, used by Argon2 for H0 and H'
+class Blake2b {
+public:
+    explicit Blake2b(size_t outlen);
+    void update(const uint8_t * data, size_t length);
+    void final(uint8_t * out);
+
+    static void hash(uint8_t * out, size_t outlen, const uint8_t * data, size_t length);
+
+private:
+    uint64_t m_h[8];
+    uint64_t m_t[2];
+    uint8_t  m_buf[128];
+    size_t   m_buflen;
+    size_t   m_outlen;
+
+    void compress(const uint8_t * block, bool last);
+};
+
+// Argon2id (RFC 9106, version 0x13). Lanes are filled sequentially on the
+// calling thread, so parallelism only changes the output, not the CPU usage.
+class Argon2id {
+public:
+    struct Params {
+        uint32_t memoryKiB = 65536;
+        uint32_t iterations = 3;
+        uint32_t parallelism = 1;
+    };
+
+    static constexpr uint32_t VERSION = 0x13;
+
+    static bool hash(const Params & params,
+                     const uint8_t * pwd, size_t pwdlen,
+                     const uint8_t * salt, size_t saltlen,
+                     uint8_t * out, size_t outlen,
+                     const uint8_t * secret = nullptr, size_t secretlen = 0,
+                     const uint8_t * ad = nullptr, size_t adlen = 0);
+
+    // Number of 1 KiB blocks actually allocated for the given parameters
+    static uint32_t memoryBlocks(const Params & params);
+
+    // Checks BLAKE2b against RFC 7693 appendix A and Argon2id against the
+    // RFC 9106 section 5.3 vector. Takes 32 KiB and a few milliseconds.
+    static bool selfTest();
+
+private:
+    struct Block {
+        uint64_t v[128];
+    };
+
+    static void hashLong(uint8_t * out, size_t outlen, const uint8_t * in, size_t inlen);
+    static void fillBlock(const Block & prev, const Block & ref, Block & next, bool withXor);
+    static void nextAddresses(Block & address, Block & input);
+};
+
+#endif
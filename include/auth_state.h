@@ -0,0 +1,76 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace PlayerRegister {
+
+// Session lifecycle of an online player:
+//   Joining -> Limbo -> Authenticating -> Authenticated -> LoggingOut
+// Resumed sessions go from Joining straight to Authenticated, a failed login
+// or registration goes from Authenticating back to Limbo, and a player can
+// leave from any state. Account facts (AUTH_VALID, AUTH_REGISTERED) stay in
+// the AuthFlag bits.
+enum class AuthState : uint8_t {
+    Joining,
+    Limbo,
+    Authenticating,
+    Authenticated,
+    LoggingOut,
+    Count
+};
+
+constexpr bool isValidTransition(AuthState from, AuthState to) {
+    if (to == AuthState::LoggingOut) return from != AuthState::LoggingOut;
+    switch (from) {
+    case AuthState::Joining:
+        return to == AuthState::Limbo || to == AuthState::Authenticated;
+    case AuthState::Limbo:
+        return to == AuthState::Authenticating;
+    case AuthState::Authenticating:
+        return to == AuthState::Limbo || to == AuthState::Authenticated;
+    default:
+        return false;
+    }
+}
+
+const char* authStateName(AuthState state);
+
+// Players per state and how long they stayed in a state before each
+// transition. Written by the main thread, readable from any thread.
+class AuthStateStats {
+public:
+    static constexpr size_t STATES = static_cast<size_t>(AuthState::Count);
+    static constexpr size_t BUCKETS = 18; // bucket 0 is < 1 ms, bucket i is [2^(i-1), 2^i) ms
+
+    static void enter(AuthState state);
+    static void leave(AuthState state);
+    static void record(AuthState from, AuthState to, std::chrono::steady_clock::duration elapsed);
+    static void reject();
+    static void reset();
+
+    static int64_t count(AuthState state);
+    static uint64_t transitions(AuthState from, AuthState to);
+    // Upper bound in ms of the bucket holding the q-quantile, 0 without samples
+    static uint64_t quantileMs(AuthState from, AuthState to, double q);
+    static uint64_t getRejected();
+    // Population per state and the latency of the transitions worth watching
+    static void describeStats(std::vector<std::string>& lines);
+
+private:
+    using Histogram = std::array<std::atomic<uint64_t>, BUCKETS>;
+
+    static Histogram& histogram(AuthState from, AuthState to);
+
+    static std::array<std::atomic<int64_t>, STATES> population_;
+    static std::array<Histogram, STATES * STATES> latency_;
+    static std::atomic<uint64_t> rejected_;
+};
+
+} // namespace PlayerRegister
@@ -0,0 +1,73 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include "credential.h"
+#include "task.h"
+
+#include <endstone/endstone.hpp>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace PlayerRegister {
+
+// Resets the passwords of many accounts at once. New secrets are hashed on
+// the hash pool a few at a time so player logins keep their share of it.
+// The account scan, the database writes and the plaintext report in
+// <data>/resets/ all run on the I/O pool, in batches, so account files keep
+// a single writer.
+class BulkReset {
+public:
+    static void init(endstone::Plugin& plugin);
+
+    // Each filter is an account name or a pattern with * and ? wildcards
+    static bool start(endstone::CommandSender& sender, const std::vector<std::string>& filters);
+    static void cancel();
+    static bool isRunning();
+
+    static bool matches(const std::string& name, const std::string& pattern);
+
+private:
+    struct Result {
+        std::string name;
+        std::string password;
+        std::optional<Credential> credential; // empty when hashing failed
+    };
+
+    struct Job {
+        std::vector<std::string> filters;
+        std::vector<std::string> names;
+        std::vector<Result> pending;
+        size_t next = 0;
+        size_t inFlight = 0;
+        size_t committing = 0; // batches on their way through the I/O pool
+        size_t committed = 0;
+        size_t failed = 0;
+        std::string requester; // player name, empty for the console
+        std::string reportPath;
+        std::ofstream report;  // I/O pool only
+        std::chrono::steady_clock::time_point started;
+        std::atomic<bool> cancelled{false};
+        bool finished = false;
+    };
+
+    static constexpr size_t BATCH_SIZE = 32;
+
+    static Task scanFlow(std::shared_ptr<Job> job);
+    static Task commitFlow(std::shared_ptr<Job> job, std::vector<Result> batch);
+    static void pump(const std::shared_ptr<Job>& job);
+    static void commit(const std::shared_ptr<Job>& job);
+    static void finish(const std::shared_ptr<Job>& job);
+    static void abort(const std::shared_ptr<Job>& job, const std::string& message);
+    static void notify(const Job& job, const std::string& message);
+
+    static endstone::Plugin* plugin_;
+    static std::shared_ptr<Job> current_;
+};
+
+} // namespace PlayerRegister
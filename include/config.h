@@ -16,6 +16,24 @@ public:
     unsigned short reconnect_port = 19132;
     bool fake_uuid = true;
     bool fake_xuid = true;
+    int hash_threads = 2;
+    int hash_queue_capacity = 64;
+    int io_queue_capacity = 256; // account file reads waiting for the I/O thread, writes are never refused
+    std::string hash_algorithm = "sha256"; // "sha256" or "argon2id"
+    int argon2_memory_kib = 65536;
+    int argon2_iterations = 3;
+    int argon2_parallelism = 1;
+    int argon2_memory_budget_mib = 256;
+    int session_resume_seconds = 120; // 0 disables resume tickets
+    int session_ticket_capacity = 1024;
+    int login_attempts_burst = 5;
+    int login_attempts_per_minute = 3;
+    std::string pepper_file = "pepper.json"; // relative to the plugin data folder
+    int pepper_grace_days = 30;
+    int admission_budget_us = 2000; // limbo setup time per tick during join storms
+    int admission_max_waiting = 0;  // players set up in limbo or logging in at once, 0 for no limit
+    int tick_budget_us = 5000;      // deferred work per tick, the rest waits for the next tick
+    std::string log_level = "info"; // "debug", "info", "warning", "error" or "off"
 
     static bool init(const std::string& configDir);
     static const Config& getInstance();
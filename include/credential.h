@@ -0,0 +1,46 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace PlayerRegister {
+
+enum class HashAlgorithm : uint8_t { None, SHA256, Argon2id };
+
+// Upper bounds for the Argon2 cost read from an account file, so a corrupt
+// or edited record cannot make a login allocate without limit
+struct CredentialLimits {
+    uint32_t maxMemoryKiB = 4 * 1024 * 1024;
+    uint32_t maxIterations = 64;
+    uint32_t maxParallelism = 64;
+};
+
+// Stored password hash kept as raw bytes in memory. The text forms (64-char
+// SHA256 hex, $sha256$k=..$hex when peppered, Argon2id PHC string) only
+// exist at the database boundary.
+struct Credential {
+    HashAlgorithm algorithm = HashAlgorithm::None;
+    uint8_t pepperId = 0; // 0 when the password was hashed without a pepper
+    uint8_t saltLength = 0;
+    uint32_t memoryKiB = 0;
+    uint32_t iterations = 0;
+    uint32_t parallelism = 0;
+    std::array<uint8_t, 16> salt{};
+    std::array<uint8_t, 32> digest{};
+
+    bool empty() const { return algorithm == HashAlgorithm::None; }
+    bool operator==(const Credential& other) const = default;
+
+    std::string toString() const;
+    static std::optional<Credential> parse(std::string_view text, const CredentialLimits& limits = CredentialLimits{});
+};
+
+// Compares digests without an early exit on the first differing byte
+bool constantTimeEqual(const std::array<uint8_t, 32>& a, const std::array<uint8_t, 32>& b);
+
+} // namespace PlayerRegister
@@ -5,6 +5,7 @@
 #include "player_manager.h"
 
 #include <string>
+#include <vector>
 #include <fstream>
 #include <nlohmann/json.hpp>
 
@@ -15,11 +16,14 @@ public:
     static bool init(const std::string& dataDir);
 
     static void storeAsPlayer(const PlayerData& data);
-    static void loadAsPlayer(PlayerData& data);
+    static bool loadAsPlayer(PlayerData& data);
     static bool removePlayer(const std::string& id);
 
     static void storeAsAccount(const PlayerData& data);
-    static void loadAsAccount(PlayerData& data);
+    static bool loadAsAccount(PlayerData& data);
+    static std::vector<std::string> listAccounts();
+
+    static const std::string& getDataDir();
 
 private:
     static std::string dataDir_;
@@ -0,0 +1,60 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#ifndef HEX_H
+#define HEX_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Table-driven hex codec for digests and identifiers
+namespace hex {
+
+inline constexpr char DIGITS[] = "0123456789abcdef";
+
+// 0xFF marks characters that are not hex digits
+inline constexpr std::array<uint8_t, 256> VALUES = []() {
+    std::array<uint8_t, 256> table{};
+    for (auto& v : table) v = 0xFF;
+    for (int i = 0; i < 10; i++) table['0' + i] = static_cast<uint8_t>(i);
+    for (int i = 0; i < 6; i++) {
+        table['a' + i] = static_cast<uint8_t>(10 + i);
+        table['A' + i] = static_cast<uint8_t>(10 + i);
+    }
+    return table;
+}();
+
+// Writes 2 * length characters to out
+constexpr void encode(const uint8_t* data, size_t length, char* out) {
+    for (size_t i = 0; i < length; i++) {
+        out[2 * i] = DIGITS[data[i] >> 4];
+        out[2 * i + 1] = DIGITS[data[i] & 0x0F];
+    }
+}
+
+inline std::string encode(const uint8_t* data, size_t length) {
+    std::string out(length * 2, '\0');
+    encode(data, length, out.data());
+    return out;
+}
+
+// Decodes exactly 2 * length characters, returns false on any non-hex digit
+constexpr bool decode(std::string_view in, uint8_t* out, size_t length) {
+    if (in.size() != length * 2) {
+        return false;
+    }
+    uint8_t bad = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t hi = VALUES[static_cast<uint8_t>(in[2 * i])];
+        uint8_t lo = VALUES[static_cast<uint8_t>(in[2 * i + 1])];
+        bad |= hi | lo;
+        out[i] = static_cast<uint8_t>((hi << 4) | (lo & 0x0F));
+    }
+    return (bad & 0xF0) == 0;
+}
+
+} // namespace hex
+
+#endif
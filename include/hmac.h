@@ -0,0 +1,54 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#ifndef HMAC_H
+#define HMAC_H
+
+#include "sha256.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// HMAC-SHA256 (RFC 2104) over the standard SHA-256 variant
+std::array<uint8_t, 32> hmacSha256(const uint8_t * key, size_t keylen, const uint8_t * data, size_t length);
+
+// Same MAC as hmacSha256(), usable in constant expressions
+constexpr std::array<uint8_t, 32> compileTimeHmacSha256(std::string_view key, std::string_view data) {
+    std::array<uint8_t, 64> block{};
+    if (key.size() > block.size()) {
+        auto digest = SHA256::compileTimeHash(key, SHA256::Variant::Standard);
+        for (size_t i = 0; i < digest.size(); i++) block[i] = digest[i];
+    } else {
+        for (size_t i = 0; i < key.size(); i++) block[i] = static_cast<uint8_t>(key[i]);
+    }
+
+    SHA256::ConstexprState inner;
+    inner.standard = true;
+    for (uint8_t b : block) inner.update(static_cast<uint8_t>(b ^ 0x36));
+    inner.update(data);
+    auto innerDigest = inner.digest();
+
+    SHA256::ConstexprState outer;
+    outer.standard = true;
+    for (uint8_t b : block) outer.update(static_cast<uint8_t>(b ^ 0x5c));
+    for (uint8_t b : innerDigest) outer.update(b);
+    return outer.digest();
+}
+
+// HMAC-SHA256 with the key's ipad/opad blocks already compressed. Each mac()
+// starts from copies of the cached midstates, so a long-lived key costs two
+// compressions less per message than hmacSha256.
+class KeyedHasher {
+public:
+    KeyedHasher();
+    KeyedHasher(const uint8_t * key, size_t keylen);
+
+    std::array<uint8_t, 32> mac(const uint8_t * data, size_t length) const;
+
+private:
+    SHA256 m_inner;
+    SHA256 m_outer;
+};
+
+#endif
@@ -0,0 +1,55 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include <endstone/endstone.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace PlayerRegister {
+
+// Slot-indexed copy of a player's inventory. Items are stored by value next
+// to their slot numbers and put back into the same slots. clear() keeps the
+// buffers, so a snapshot that is reused costs no allocations of its own.
+class InventorySnapshot {
+public:
+    void capture(const endstone::PlayerInventory& inventory)
+    {
+        clear();
+        const int size = inventory.getSize();
+        slots_.reserve(size);
+        items_.reserve(size);
+        for (int slot = 0; slot < size; slot++) {
+            if (auto item = inventory.getItem(slot)) {
+                slots_.push_back(static_cast<uint16_t>(slot));
+                items_.push_back(*item);
+            }
+        }
+    }
+
+    // Empty slots of the snapshot are cleared, every other slot gets its item back
+    void restore(endstone::PlayerInventory& inventory) const
+    {
+        inventory.clear();
+        for (size_t i = 0; i < items_.size(); i++) {
+            inventory.setItem(slots_[i], &items_[i]);
+        }
+    }
+
+    void clear()
+    {
+        slots_.clear();
+        items_.clear();
+    }
+
+    size_t size() const { return items_.size(); }
+    bool empty() const { return items_.empty(); }
+    uint16_t slotAt(size_t i) const { return slots_[i]; }
+    const endstone::ItemStack& itemAt(size_t i) const { return items_[i]; }
+
+private:
+    std::vector<uint16_t> slots_;
+    std::vector<endstone::ItemStack> items_;
+};
+
+} // namespace PlayerRegister
@@ -0,0 +1,105 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include <endstone/endstone.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace PlayerRegister {
+
+struct LimboState;
+
+// What a player had before being moved to the auth area
+struct LimboRecord {
+    struct Item {
+        uint16_t slot = 0;
+        std::string type;
+        int amount = 0;
+        int data = 0;
+        bool lossy = false; // had metadata the journal could not keep
+    };
+
+    std::string id;
+    bool hasLocation = false;
+    std::string dimension;
+    float x = 0.0f, y = 0.0f, z = 0.0f, yaw = 0.0f, pitch = 0.0f;
+    std::vector<Item> items;
+};
+
+// Append-only JSON-lines journal of limbo snapshots in limbo.journal. An
+// "enter" line is written when a player's state is saved and a "restore"
+// tombstone once it was given back. Entries without a tombstone survive a
+// crash or a quit in limbo and are handed back on the player's next join.
+//
+// The join path only queues records; one background thread serializes them,
+// appends each batch with a single write and rewrites the file with just the
+// open entries once tombstones make up most of it. Items are journaled by
+// type, amount and data value. Metadata (names, lore, enchantments) is not
+// kept; such slots are flagged so recovery can report what it lost.
+class LimboJournal {
+public:
+    struct Stats {
+        size_t pending = 0; // open entries
+        uint64_t appended = 0;
+        uint64_t batches = 0;
+        uint64_t compactions = 0;
+        uint64_t recovered = 0;
+    };
+
+    // Replays the journal, compacts it and starts the writer
+    static bool open(const std::string& dataDir);
+    // Writes everything still queued and stops the writer
+    static void close();
+
+    static void recordEnter(const std::string& id, const LimboState& limbo);
+    static void recordRestore(const std::string& id);
+    // Closes the open entry of a joining player and returns it, if there is one
+    static std::optional<LimboRecord> take(const std::string& id);
+
+    static Stats getStats();
+    static void describeStats(std::vector<std::string>& lines);
+
+private:
+    struct Op {
+        bool enter;
+        LimboRecord record;
+    };
+
+    static constexpr std::chrono::milliseconds BATCH_WINDOW{50};
+    static constexpr uint64_t COMPACT_SLACK = 256; // tombstoned lines tolerated before a rewrite
+
+    static void push(Op op);
+    static void writerLoop();
+    static void writeBatch(std::vector<Op>& batch);
+    static bool compact();
+
+    static std::string path_;
+    static std::unordered_map<std::string, LimboRecord> open_; // main thread
+    static uint64_t recovered_;
+
+    static std::mutex mutex_;
+    static std::condition_variable cv_;
+    static std::vector<Op> queue_;
+    static bool running_;
+    static std::thread thread_;
+
+    // Writer thread only
+    static std::FILE* file_;
+    static std::unordered_map<std::string, std::string> live_; // id -> enter line
+    static uint64_t linesInFile_;
+    static std::atomic<uint64_t> appended_;
+    static std::atomic<uint64_t> batches_;
+    static std::atomic<uint64_t> compactions_;
+};
+
+} // namespace PlayerRegister
@@ -0,0 +1,119 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include <endstone/endstone.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace PlayerRegister {
+
+enum class LogLevel : uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off,
+};
+
+// One key=value pair of a log record. Values are only referenced, they are
+// rendered into the ring slot by the producing thread.
+class LogField {
+public:
+    LogField(const char* key, std::string_view value) : key_(key), type_(Type::String), string_(value) {}
+    LogField(const char* key, const std::string& value) : LogField(key, std::string_view(value)) {}
+    LogField(const char* key, const char* value) : LogField(key, std::string_view(value)) {}
+    LogField(const char* key, double value) : key_(key), type_(Type::Real), real_(value) {}
+
+    template <typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    LogField(const char* key, T value) : key_(key)
+    {
+        if constexpr (std::is_signed_v<T>) {
+            type_ = Type::Signed;
+            signed_ = value;
+        } else {
+            type_ = Type::Unsigned;
+            unsigned_ = value;
+        }
+    }
+
+private:
+    friend class Log;
+    enum class Type : uint8_t { String, Signed, Unsigned, Real };
+
+    const char* key_;
+    Type type_;
+    std::string_view string_;
+    union {
+        int64_t signed_;
+        uint64_t unsigned_;
+        double real_;
+    };
+};
+
+// Plugin logger. The level is checked before any argument is evaluated (see
+// the LOG_* macros); records are formatted straight into a fixed-size slot of
+// a bounded lock-free ring and handed to the server logger by one background
+// thread. When the ring is full records are dropped and counted.
+class Log {
+public:
+    static void start(endstone::Plugin& plugin, LogLevel level);
+    static void stop();
+    static bool parseLevel(std::string_view name, LogLevel& level);
+
+    static bool enabled(LogLevel level)
+    {
+        return static_cast<uint8_t>(level) >= level_.load(std::memory_order_relaxed);
+    }
+
+    static void write(LogLevel level, std::string_view event, std::initializer_list<LogField> fields);
+
+    static uint64_t getWritten();
+    static uint64_t getDropped();
+    static void describeStats(std::vector<std::string>& lines);
+
+private:
+    static constexpr size_t CAPACITY = 1024; // power of two
+    static constexpr size_t RECORD_SIZE = 240;
+
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        LogLevel level = LogLevel::Info;
+        uint16_t length = 0;
+        char text[RECORD_SIZE];
+    };
+
+    static void drain();
+    static bool pop(std::string& out, LogLevel& level);
+
+    static std::atomic<uint8_t> level_;
+    static std::array<Slot, CAPACITY> ring_;
+    static std::atomic<size_t> head_; // next slot to claim by producers
+    static size_t tail_;              // next slot to read, owned by the drain thread
+    static std::atomic<uint64_t> written_;
+    static std::atomic<uint64_t> dropped_;
+    static std::atomic<bool> running_;
+    static std::thread thread_;
+    static endstone::Logger* logger_;
+};
+
+} // namespace PlayerRegister
+
+#define LOG_AT(level, event, ...)                                                        \
+    do {                                                                                 \
+        if (::PlayerRegister::Log::enabled(level)) {                                     \
+            ::PlayerRegister::Log::write(level, event, {__VA_ARGS__});                   \
+        }                                                                                \
+    } while (0)
+
+#define LOG_DEBUG(event, ...) LOG_AT(::PlayerRegister::LogLevel::Debug, event, __VA_ARGS__)
+#define LOG_INFO(event, ...) LOG_AT(::PlayerRegister::LogLevel::Info, event, __VA_ARGS__)
+#define LOG_WARNING(event, ...) LOG_AT(::PlayerRegister::LogLevel::Warning, event, __VA_ARGS__)
+#define LOG_ERROR(event, ...) LOG_AT(::PlayerRegister::LogLevel::Error, event, __VA_ARGS__)
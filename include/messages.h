@@ -0,0 +1,197 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include <endstone/endstone.hpp>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace PlayerRegister {
+
+// Every player-facing text. Keys in lang files are listed in messages.cpp.
+enum class MsgId : uint16_t {
+    RequestPending,
+    ServerBusy,
+    HashFailed,
+    PasswordTooShort,
+    NewPasswordTooShort,
+    PasswordsMismatch,
+    NewPasswordsMismatch,
+    AccountExists,
+    MaxAccounts,
+    AccountCreated,
+    AccountNotFound,
+    WrongPassword,
+    WrongOldPassword,
+    LoginSuccess,
+    PasswordChanged,
+    NotLoggedIn,
+    TooManyLoginAttempts,
+    LogoutSuccess,
+    RegisterHelp,
+    LoginHelp,
+    ChangePasswordHelp,
+    AccountInfo,
+    AccountInfoGuest,
+    AccountCommands,
+    ChatBlocked,
+    CommandBlocked,
+    Welcome,
+    AuthQueued,
+    Frozen,
+    Unfrozen,
+    RegistrationKick,
+    RegistrationTimeLeft,
+    AuthTitle,
+    AuthSubtitle,
+    AuthTimeout,
+    AuthTimeLeft,
+    AuthHints,
+    AuthTitleUrgent,
+    AuthTitleNormal,
+    AuthSubtitleTimeLeft,
+    AuthSuccess,
+    SessionResumed,
+    Reconnect,
+    PasswordResetKick,
+    // Operator commands
+    ResetPasswordUsage,
+    ResetPasswordDone,
+    ResetPasswordFailed,
+    ResetPasswordsUsage,
+    BulkResetRunning,
+    BulkResetNoMatches,
+    BulkResetReportFailed,
+    BulkResetFound,
+    BulkResetProgress,
+    BulkResetFinished,
+    PepperRotationPending,
+    PepperSaveFailed,
+    PepperRotated,
+    StatsHeader,
+    StatsHashThreads,
+    StatsHashCounts,
+    StatsHashLatency,
+    StatsIoPool,
+    StatsArgon2Memory,
+    StatsPlayers,
+    StatsSnapshot,
+    StatsStates,
+    StatsStateItem,
+    StatsTransition,
+    StatsSchedulerTick,
+    StatsQueue,
+    QueueAuth,
+    QueuePersistence,
+    QueueReminders,
+    QueueHousekeeping,
+    StatsAdmission,
+    StatsJoinStages,
+    StatsQuitStages,
+    StatsStageItem,
+    StatsJournal,
+    StatsPepper,
+    StatsTickets,
+    StatsRateLimiter,
+    StatsLog,
+    Count
+};
+
+// One formatting argument, integers are rendered on the stack
+class MsgArg {
+public:
+    MsgArg(std::string_view value) : view_(value) {}
+    MsgArg(const std::string& value) : view_(value) {}
+    MsgArg(const char* value) : view_(value) {}
+
+    template <typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    MsgArg(T value)
+    {
+        auto result = std::to_chars(buffer_, buffer_ + sizeof(buffer_), value);
+        view_ = std::string_view(buffer_, static_cast<size_t>(result.ptr - buffer_));
+    }
+
+    MsgArg(const MsgArg&) = delete;
+    MsgArg& operator=(const MsgArg&) = delete;
+
+    std::string_view view() const { return view_; }
+
+private:
+    char buffer_[24];
+    std::string_view view_;
+};
+
+// Message catalog: built-in Russian texts, optionally overridden from
+// lang/<lang>.json at startup and then left immutable. Templates use {0},
+// {1}... placeholders and are split into literal and argument segments once,
+// so formatting is only appends into a reused buffer.
+class Messages {
+public:
+    static bool load(const std::string& langDir, const std::string& lang);
+    static const char* key(MsgId id);
+
+    // The result lives in a thread-local buffer until the next format call on
+    // the same thread; texts without arguments are returned prebuilt
+    template <typename... Args>
+    static const std::string& format(MsgId id, const Args&... args)
+    {
+        if constexpr (sizeof...(Args) == 0) {
+            return entries_[index(id)].whole;
+        } else {
+            const MsgArg converted[] = {args...};
+            return formatArgs(id, converted, sizeof...(Args));
+        }
+    }
+
+    // Sends each line of a (possibly multi-line) message separately
+    template <typename... Args>
+    static void send(const endstone::CommandSender& to, MsgId id, const Args&... args)
+    {
+        if constexpr (sizeof...(Args) == 0) {
+            sendArgs(to, id, nullptr, 0);
+        } else {
+            const MsgArg converted[] = {args...};
+            sendArgs(to, id, converted, sizeof...(Args));
+        }
+    }
+
+private:
+    struct Segment {
+        uint32_t offset;
+        uint32_t length;
+        int arg; // -1 for literal text
+    };
+
+    struct Line {
+        std::string text; // final text, or the raw template when it has arguments
+        std::vector<Segment> segments;
+        bool hasArgs = false;
+    };
+
+    struct Entry {
+        std::vector<Line> lines;
+        std::string whole; // all lines joined, only meaningful without arguments
+    };
+
+    static size_t index(MsgId id) { return static_cast<size_t>(id); }
+    static void compile(Entry& entry, const std::string& text);
+    static void appendLine(std::string& out, const Line& line, const MsgArg* args, size_t count);
+    static const std::string& formatArgs(MsgId id, const MsgArg* args, size_t count);
+    static void sendArgs(const endstone::CommandSender& to, MsgId id, const MsgArg* args, size_t count);
+    static bool exportDefaults(const std::string& path);
+
+    static std::array<Entry, static_cast<size_t>(MsgId::Count)> entries_;
+};
+
+template <typename... Args>
+const std::string& msg(MsgId id, const Args&... args)
+{
+    return Messages::format(id, args...);
+}
+
+} // namespace PlayerRegister
@@ -0,0 +1,77 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include "argon2.h"
+#include "credential.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace PlayerRegister {
+
+// Produces and checks password credentials. Accounts created with SHA256
+// keep verifying after switching to Argon2id, since the algorithm and the
+// pepper key id are part of each stored credential.
+class PasswordHasher {
+public:
+    static void init();
+
+    // Called from hash pool workers. Empty when the pepper key or the Argon2
+    // memory is unavailable; nothing may be stored then.
+    static std::optional<Credential> hash(const std::string& password);
+    static bool verify(const std::string& password, const Credential& stored);
+
+    // True when a credential was made with another algorithm, cost or pepper key
+    static bool needsRehash(const Credential& stored);
+
+    static HashAlgorithm getAlgorithm();
+    static uint64_t getMemoryInUseKiB();
+    static uint64_t getMemoryBudgetKiB();
+    static void describeStats(std::vector<std::string>& lines);
+    // Largest Argon2 cost a stored credential may ask for
+    static CredentialLimits getCredentialLimits();
+
+private:
+    // Replaces the password with its HMAC under the given pepper key
+    static bool prepare(const std::string& password, uint8_t pepperId, std::string& out);
+
+    static std::optional<Credential> hashArgon2(const std::string& password);
+    static bool verifyArgon2(const std::string& password, const Credential& stored);
+
+    // Holds Argon2 memory from the budget until it goes out of scope. Blocks
+    // the calling worker until the memory fits; a request larger than the
+    // whole budget is refused instead.
+    class MemoryReservation {
+    public:
+        explicit MemoryReservation(uint64_t kib) : kib_(acquireMemory(kib) ? kib : 0) {}
+        ~MemoryReservation()
+        {
+            if (kib_ > 0) releaseMemory(kib_);
+        }
+        MemoryReservation(const MemoryReservation&) = delete;
+        MemoryReservation& operator=(const MemoryReservation&) = delete;
+
+        explicit operator bool() const { return kib_ > 0; }
+
+    private:
+        uint64_t kib_;
+    };
+
+    static bool acquireMemory(uint64_t kib);
+    static void releaseMemory(uint64_t kib);
+
+    static HashAlgorithm algorithm_;
+    static bool argon2Verified_; // the Argon2id self-test passed in init()
+    static Argon2id::Params argon2Params_;
+    static std::mutex budgetMutex_;
+    static std::condition_variable budgetCv_;
+    static uint64_t budgetInUseKiB_;
+    static uint64_t budgetLimitKiB_;
+};
+
+} // namespace PlayerRegister
@@ -0,0 +1,59 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include "hmac.h"
+
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace PlayerRegister {
+
+// Server-wide secret mixed into every password before it is hashed. The
+// key file is read once at Config::init and kept as cached HMAC midstates.
+//
+// Rotation generates a new current key and keeps the old one for a grace
+// window, so accounts hashed under it can still log in and get rehashed
+// with the new key. Key ids are stored in each credential; 0 means none.
+class Pepper {
+public:
+    static bool load(const std::string& path, int graceDays);
+    static bool rotate();
+
+    static uint8_t currentId();
+    static uint8_t previousId();
+    static std::time_t previousExpires();
+    static void describeStats(std::vector<std::string>& lines);
+
+    // Thread-safe; false if the key id is unknown or past its grace window
+    static bool apply(uint8_t id, const std::string& password, std::array<uint8_t, 32>& out);
+
+private:
+    struct Key {
+        uint8_t id = 0;
+        std::array<uint8_t, 32> secret{};
+        KeyedHasher hasher;
+        std::time_t expires = 0; // 0 for the current key
+    };
+
+    struct Ring {
+        std::shared_ptr<const Key> current;
+        std::shared_ptr<const Key> previous;
+    };
+
+    static std::shared_ptr<const Key> makeKey(uint8_t id, const std::array<uint8_t, 32>& secret, std::time_t expires);
+    static bool save(const Ring& ring);
+    static Ring snapshot();
+
+    static std::mutex mutex_;
+    static Ring ring_;
+    static std::string path_;
+    static int graceDays_;
+};
+
+} // namespace PlayerRegister
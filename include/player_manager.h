@@ -2,133 +2,179 @@
 
 #pragma once
 
+#include "auth_state.h"
+#include "credential.h"
+#include "inventory_snapshot.h"
+#include "rcu.h"
+#include "slot_map.h"
+#include "timing_wheel.h"
+#include "uuid_index.h"
+
 #include <endstone/endstone.hpp>
+#include <array>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <chrono>
+#include <deque>
 #include <memory>
 #include <optional>
+#include <vector>
 
 namespace PlayerRegister {
 
+// Account record of an online player. Auth flags and limbo state are kept
+// outside of it by PlayerManager, see AuthFlag and LimboState. Records are
+// move-only, edit them in place through PlayerManager::update().
 struct PlayerData {
+    PlayerData() = default;
+    PlayerData(const PlayerData&) = delete;
+    PlayerData& operator=(const PlayerData&) = delete;
+    PlayerData(PlayerData&&) = default;
+    PlayerData& operator=(PlayerData&&) = default;
+
     std::string id;
+    endstone::UUID uuid; // real UUID of the online player, not persisted
     std::string name;
-    std::string password;
+    Credential password;
     int accounts = 0;
 
     endstone::UUID fakeUUID;
     std::string fakeXUID;
     std::string fakeDBkey;
+};
 
-    bool valid = false;
-    bool isRegistered = false;
-    bool isAuthenticated = false;
+// Per-slot auth state packed into one byte, so chat and command gates
+// don't touch the PlayerData record at all
+enum AuthFlag : uint8_t {
+    AUTH_VALID = 1 << 0, // an account record is loaded
+    AUTH_REGISTERED = 1 << 1,
+    AUTH_AUTHENTICATED = 1 << 2,
+    AUTH_FROZEN = 1 << 3,
+};
+
+// Cold state that only exists while a player is waiting to log in
+struct LimboState {
+    endstone::Player* player = nullptr; // valid until the player is unloaded
     std::chrono::steady_clock::time_point joinTime;
-    bool isFrozen = false;
-    std::shared_ptr<endstone::Task> kickTask;
-    std::shared_ptr<endstone::Task> reminderTask;
-    
-    // New fields for authorization system
-    std::unique_ptr<endstone::Location> originalLocation;
+    std::chrono::steady_clock::time_point authStart; // the deadline runs from here, set on admission
+    TimingWheel::TimerId kickTimer;
+    TimingWheel::TimerId reminderTimer;
+    TimingWheel::TimerId authTimer;
+
+    bool prepared = false; // state saved and player moved to the auth area
+    std::optional<endstone::Location> originalLocation;
     float originalYaw = 0.0f;
     float originalPitch = 0.0f;
-    std::vector<std::unique_ptr<endstone::ItemStack>> savedInventory;
-    std::shared_ptr<endstone::Task> authTimerTask;
-    std::shared_ptr<endstone::Task> authReminderTask;
-    
-    // Default constructor
-    PlayerData() = default;
-    
-    // Copy constructor
-    PlayerData(const PlayerData& other) 
-        : id(other.id)
-        , name(other.name)
-        , password(other.password)
-        , accounts(other.accounts)
-        , fakeUUID(other.fakeUUID)
-        , fakeXUID(other.fakeXUID)
-        , fakeDBkey(other.fakeDBkey)
-        , valid(other.valid)
-        , isRegistered(other.isRegistered)
-        , isAuthenticated(other.isAuthenticated)
-        , joinTime(other.joinTime)
-        , isFrozen(other.isFrozen)
-        , kickTask(other.kickTask)
-        , reminderTask(other.reminderTask)
-        , originalLocation(other.originalLocation ? std::make_unique<endstone::Location>(*other.originalLocation) : nullptr)
-        , originalYaw(other.originalYaw)
-        , originalPitch(other.originalPitch)
-        , authTimerTask(other.authTimerTask)
-        , authReminderTask(other.authReminderTask)
+    InventorySnapshot savedInventory;
+
+    // Clears the state for the next player, the inventory buffers are kept
+    void reset()
     {
-        // Deep copy the inventory
-        savedInventory.reserve(other.savedInventory.size());
-        for (const auto& item : other.savedInventory) {
-            if (item) {
-                savedInventory.push_back(std::make_unique<endstone::ItemStack>(*item));
-            }
-        }
-    }
-    
-    // Copy assignment operator
-    PlayerData& operator=(const PlayerData& other) {
-        if (this != &other) {
-            id = other.id;
-            name = other.name;
-            password = other.password;
-            accounts = other.accounts;
-            fakeUUID = other.fakeUUID;
-            fakeXUID = other.fakeXUID;
-            fakeDBkey = other.fakeDBkey;
-            valid = other.valid;
-            isRegistered = other.isRegistered;
-            isAuthenticated = other.isAuthenticated;
-            joinTime = other.joinTime;
-            isFrozen = other.isFrozen;
-            kickTask = other.kickTask;
-            reminderTask = other.reminderTask;
-            originalLocation = other.originalLocation ? std::make_unique<endstone::Location>(*other.originalLocation) : nullptr;
-            originalYaw = other.originalYaw;
-            originalPitch = other.originalPitch;
-            authTimerTask = other.authTimerTask;
-            authReminderTask = other.authReminderTask;
-            
-            // Deep copy the inventory
-            savedInventory.clear();
-            savedInventory.reserve(other.savedInventory.size());
-            for (const auto& item : other.savedInventory) {
-                if (item) {
-                    savedInventory.push_back(std::make_unique<endstone::ItemStack>(*item));
-                }
-            }
-        }
-        return *this;
+        player = nullptr;
+        kickTimer = reminderTimer = authTimer = TimingWheel::TimerId{};
+        prepared = false;
+        originalLocation.reset();
+        originalYaw = 0.0f;
+        originalPitch = 0.0f;
+        savedInventory.clear();
     }
-    
-    // Move constructor
-    PlayerData(PlayerData&& other) noexcept = default;
-    
-    // Move assignment operator
-    PlayerData& operator=(PlayerData&& other) noexcept = default;
+};
+
+// Read-only copy of every online player's auth state, published by the main
+// thread at the end of a tick in which something changed. Other threads read
+// it through PlayerManager::getSnapshot() without taking any lock.
+struct AuthSnapshot {
+    struct Entry {
+        endstone::UUID uuid;
+        std::string account; // empty until an account record is loaded
+        uint8_t flags = 0;   // AuthFlag bits
+        AuthState state = AuthState::Joining;
+        bool inLimbo = false;
+    };
+
+    uint64_t version = 0;
+    size_t limbo = 0;
+    size_t authenticated = 0;
+    std::vector<Entry> players; // sorted by UUID bytes
+
+    const Entry* find(const endstone::UUID& uuid) const;
 };
 
 class PlayerManager {
 public:
+    using Handle = SlotHandle;
+
+    struct AdmissionStats {
+        size_t queued = 0;
+        size_t maxQueued = 0;
+        uint64_t admitted = 0;
+        uint64_t held = 0; // ticks that stopped at admission_max_waiting
+        uint64_t lastTickUs = 0;
+        uint64_t maxTickUs = 0;
+    };
+
+    struct StageStats {
+        const char* name = "";
+        uint64_t runs = 0;
+        uint64_t totalUs = 0;
+        uint64_t maxUs = 0;
+    };
+
     static void setPlugin(endstone::Plugin* plugin);
+    static endstone::Plugin* getPlugin();
+    static void startTimers();
+    static void stopTimers();
+    static void tick(); // called once per server tick by WorkScheduler
     static endstone::UUID getRealUUID(endstone::Player* pl);
     static endstone::UUID getFakeUUID(endstone::Player* pl);
 
     static std::string getFakeDBkey(const std::string& real);
     static void setFakeDBkey(endstone::Player* pl);
-    static void setPlayerData(endstone::Player* pl, PlayerData& data);
+    static void setPlayerData(endstone::Player* pl, PlayerData&& data);
 
+    // The join and quit pipelines, called once per event by the listener
     static void loadPlayer(endstone::Player* pl);
     static void unloadPlayer(endstone::Player* pl);
+    // Any thread, with an Epoch::Guard held while the result is used. Never
+    // null; lags the live state by at most one tick.
+    static const AuthSnapshot* getSnapshot();
+    static uint64_t getSnapshotVersion(); // main thread
+    static size_t getRetiredSnapshots();  // main thread
+    // Any thread: true once a snapshot newer than `since` no longer lists the player
+    static bool hasLeft(const endstone::UUID& uuid, uint64_t since);
+    static std::vector<StageStats> getJoinStageStats();
+    static std::vector<StageStats> getQuitStageStats();
 
     static const PlayerData& getPlayerData(endstone::Player* pl);
+    static Handle getHandle(endstone::Player* pl);
+    static PlayerData* get(Handle handle);
+
+    // Runs fn on the live record, returns false if the handle went stale
+    template <typename Fn>
+    static bool update(Handle handle, Fn&& fn)
+    {
+        PlayerData* data = players_.get(handle);
+        if (!data) return false;
+        fn(*data);
+        return true;
+    }
+    static AuthState getAuthState(endstone::Player* pl);
+    // Moves the player along the AuthState lifecycle; an invalid transition is
+    // logged, counted and refused. Moving to the current state does nothing.
+    static bool transition(endstone::Player* pl, AuthState to);
+    static uint8_t getAuthFlags(endstone::Player* pl);
+    static void setAuthFlags(endstone::Player* pl, uint8_t flags);
+    static bool hasAccount(endstone::Player* pl);
+    static size_t getLimboCount();
+    static size_t getTimerCount();
+    static AdmissionStats getAdmissionStats();
+    // Population, snapshot, admission and join/quit stage lines for /authstats
+    static void describeStats(std::vector<std::string>& lines);
     static endstone::Player* getPlayerByUUID(const endstone::UUID& uuid);
-    static const std::unordered_map<endstone::Player*, PlayerData>& getAllData();
+    static const SlotMap<PlayerData>& getAllData();
+    // Gives players still in limbo their saved state back, called before
+    // clearAllData() on shutdown while the full snapshots still exist
+    static void restoreLimboPlayers();
     static void clearAllData();
     static std::string getId(endstone::Player* pl);
     static void reconnect(endstone::Player* pl);
@@ -158,16 +204,102 @@ public:
     static bool isCommandAllowed(const std::string& command);
     static bool isPlayerAuthorized(endstone::Player* pl);
     
+    // Parses 32 hex digits with optional hyphens, nullopt on anything else
+    static std::optional<endstone::UUID> parseUUID(std::string_view text);
     // Helper function to parse UUID from string
     static endstone::UUID parseUUIDFromString(const std::string& uuidStr);
 
 private:
+    enum TimerKind : uint8_t {
+        TIMER_KICK,
+        TIMER_REMINDER,
+        TIMER_AUTH_TIMEOUT,
+        TIMER_AUTH_BROADCAST,
+    };
+
+    // One reminder text shared by every limbo player in the same time bucket
+    struct ReminderBucket {
+        std::string message;
+        std::string title;
+        std::string subtitle;
+        std::vector<endstone::Player*> players;
+    };
+
+    // One named step of the join or quit pipeline, returns false to skip the remaining steps
+    struct Stage {
+        const char* name;
+        bool (*run)(endstone::Player* pl);
+    };
+
+    struct StageTimes {
+        uint64_t runs = 0;
+        uint64_t totalUs = 0;
+        uint64_t maxUs = 0;
+    };
+
+    static constexpr size_t JOIN_STAGES = 4;
+    static constexpr size_t QUIT_STAGES = 5;
+
+    static void publishSnapshot();
+    static void runStages(const Stage* stages, StageTimes* times, size_t count, endstone::Player* pl);
+    static std::vector<StageStats> collectStageStats(const Stage* stages, const StageTimes* times, size_t count);
+    static bool joinRecover(endstone::Player* pl);
+    static bool joinResume(endstone::Player* pl);
+    static bool joinRecord(endstone::Player* pl);
+    static bool joinGate(endstone::Player* pl);
+    static bool quitLeave(endstone::Player* pl);
+    static bool quitTicket(endstone::Player* pl);
+    static bool quitTimers(endstone::Player* pl);
+    static bool quitLimbo(endstone::Player* pl);
+    static bool quitRecord(endstone::Player* pl);
+
     static endstone::Plugin* plugin_;
-    static std::unordered_map<endstone::Player*, PlayerData> playerDataMap;
+    static PlayerData* find(endstone::Player* pl);
+    static uint8_t* findFlags(endstone::Player* pl);
+    static LimboState* findLimbo(endstone::Player* pl);
+    static LimboState& enterLimbo(endstone::Player* pl);
+    static void leaveLimbo(endstone::Player* pl);
+    static void cancelTimer(TimingWheel::TimerId& id);
+    static void onTimer(Handle owner, uint8_t kind);
+    static void broadcastAuthReminders();
+    static void prepareLimbo(endstone::Player* pl);
+    static void processAdmissions();
+    static void formatAuthReminder(ReminderBucket& bucket, int secondsLeft);
+    static void deliverAuthReminder(endstone::Player* pl, const ReminderBucket& bucket, int secondsLeft);
+
+    // flags_ and limbo_ are indexed by slot index, not by dense position
+    static SlotMap<PlayerData> players_;
+    static UuidIndex index_;
+    static std::vector<uint8_t> flags_;
+    static std::vector<std::unique_ptr<LimboState>> limbo_;
+    static std::vector<std::unique_ptr<LimboState>> limboPool_; // released states, reused on the next join
+    struct Lifecycle {
+        AuthState state = AuthState::Joining;
+        std::chrono::steady_clock::time_point since;
+    };
+    static std::vector<Lifecycle> lifecycle_;
+    // Every limbo deadline and reminder shares one wheel, advanced from tick()
+    static TimingWheel timers_;
+    static std::vector<ReminderBucket> reminderBuckets_;
+    // Joined players waiting for limbo setup, worked off under a per-tick budget
+    static std::deque<Handle> admission_;
+    static AdmissionStats admissionStats_;
+    // Limbo states with prepared set, released in leaveLimbo
+    static size_t preparedCount_;
+    static const Stage joinStages_[JOIN_STAGES];
+    static const Stage quitStages_[QUIT_STAGES];
+    static std::array<StageTimes, JOIN_STAGES> joinTimes_;
+    static std::array<StageTimes, QUIT_STAGES> quitTimes_;
+    // Set by every change to records, flags or limbo membership
+    static bool snapshotDirty_;
+    static uint64_t snapshotVersion_;
+    static RcuCell<AuthSnapshot> snapshot_;
     static const std::chrono::seconds KICK_DELAY;
     static const std::chrono::seconds REMINDER_INTERVAL;
     static const std::chrono::seconds AUTH_TIMEOUT;
     static const std::chrono::seconds AUTH_REMINDER_INTERVAL;
+    static const std::chrono::seconds AUTH_REMINDER_BUCKET;
+    static const std::chrono::seconds AUTH_REMINDER_GRACE;
 };
 
 } // namespace PlayerRegister
\ No newline at end of file
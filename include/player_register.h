@@ -4,9 +4,17 @@
 
 #include "player_register_listener.h"
 #include "player_register_command.h"
+#include "account_manager.h"
+#include "bulk_reset.h"
 #include "config.h"
 #include "database.h"
+#include "limbo_journal.h"
+#include "log.h"
+#include "messages.h"
 #include "player_manager.h"
+#include "rate_limiter.h"
+#include "session_tickets.h"
+#include "work_scheduler.h"
 
 #include <endstone/endstone.hpp>
 #include <memory>
@@ -30,6 +38,11 @@ public:
             return;
         }
         
+        // Message overrides are optional, a broken file only costs the translations
+        if (!PlayerRegister::Messages::load(getDataFolder().string() + "/lang", CONF.lang)) {
+            getLogger().warning("Failed to parse lang/{}.json, using built-in messages.", CONF.lang);
+        }
+        
         getLogger().info("Configuration and database initialized successfully.");
     }
 
@@ -37,8 +50,29 @@ public:
     {
         getLogger().info("PlayerRegister plugin enabled!");
 
+        // Start logging first so every other subsystem can trace its startup
+        PlayerRegister::LogLevel level = PlayerRegister::LogLevel::Info;
+        if (!PlayerRegister::Log::parseLevel(CONF.log_level, level)) {
+            getLogger().warning("Unknown log_level '{}', using info.", CONF.log_level);
+        }
+        PlayerRegister::Log::start(*this, level);
+
+        // Replay limbo snapshots left by a crash before anyone can join
+        if (!PlayerRegister::LimboJournal::open(getDataFolder().string())) {
+            getLogger().error("Failed to open limbo journal, limbo state will not survive a crash!");
+        }
+
         // Set plugin reference for PlayerManager
         PlayerRegister::PlayerManager::setPlugin(this);
+        PlayerRegister::PlayerManager::startTimers();
+
+        // One tick task runs the limbo timers and all deferred work, then start the hashing pool
+        PlayerRegister::WorkScheduler::start(*this);
+        PlayerRegister::WorkScheduler::addTickHook(&PlayerRegister::PlayerManager::tick);
+        PlayerRegister::AccountManager::init();
+        PlayerRegister::SessionTickets::init();
+        PlayerRegister::RateLimiter::init();
+        PlayerRegister::BulkReset::init(*this);
 
         // Set up command executors for all commands
         if (auto *command = getCommand("register")) {
@@ -61,16 +95,26 @@ public:
             command->setExecutor(std::make_unique<PlayerRegisterCommandExecutor>());
         }
 
+        if (auto *command = getCommand("resetpasswords")) {
+            command->setExecutor(std::make_unique<PlayerRegisterCommandExecutor>());
+        }
+
+        if (auto *command = getCommand("rotatepepper")) {
+            command->setExecutor(std::make_unique<PlayerRegisterCommandExecutor>());
+        }
+
         if (auto *command = getCommand("logout")) {
             command->setExecutor(std::make_unique<PlayerRegisterCommandExecutor>());
         }
 
+        if (auto *command = getCommand("authstats")) {
+            command->setExecutor(std::make_unique<PlayerRegisterCommandExecutor>());
+        }
+
         // Register event handlers
-        registerEvent(&PlayerRegisterPlugin::onPlayerJoin, *this);
-        registerEvent(&PlayerRegisterPlugin::onPlayerQuit, *this);
         registerEvent(&PlayerRegisterPlugin::onServerLoad, *this);
 
-        // Register listener for additional events
+        // The listener owns the join/quit pipeline and the chat and command gates
         listener_ = std::make_unique<PlayerRegisterListener>(*this);
         registerEvent(&PlayerRegisterListener::onServerLoad, *listener_, endstone::EventPriority::High);
         registerEvent(&PlayerRegisterListener::onPlayerJoin, *listener_, endstone::EventPriority::High);
@@ -84,42 +128,20 @@ public:
     void onDisable() override
     {
         getLogger().info("PlayerRegister plugin disabled!");
-        
-        // Clean up player data
-        PlayerRegister::PlayerManager::clearAllData();
-    }
 
-    // Event handlers
-    void onPlayerJoin(endstone::PlayerJoinEvent &event)
-    {
-        auto& player = event.getPlayer();
-        getLogger().info("Player joined: {}", player.getName());
-        
-        // Load player data when they join
-        PlayerRegister::PlayerManager::loadPlayer(&player);
+        // Stop hashing before the completion queue so no callback outlives the plugin
+        PlayerRegister::BulkReset::cancel();
+        PlayerRegister::AccountManager::shutdown();
+        PlayerRegister::WorkScheduler::stop();
+        PlayerRegister::PlayerManager::stopTimers();
         
-        // Check if player needs to login (not registered)
-        if (!PlayerRegister::PlayerManager::isPlayerRegistered(&player)) {
-            // Player is already frozen by loadPlayer, just send initial message
-            player.sendMessage(endstone::ColorFormat::Yellow + "Добро пожаловать на сервер!");
-            player.sendMessage(endstone::ColorFormat::Gold + "Пожалуйста, зарегистрируйтесь или войдите в аккаунт чтобы играть.");
-            player.sendMessage(endstone::ColorFormat::Gold + "Используйте /register <пароль> <подтверждение> для регистрации");
-            player.sendMessage(endstone::ColorFormat::Gold + "Или /login <пароль> для входа в существующий аккаунт");
-        } else {
-            // Player is already registered, make sure they're not frozen
-            if (PlayerRegister::PlayerManager::isPlayerFrozen(&player)) {
-                PlayerRegister::PlayerManager::unfreezePlayer(&player);
-            }
-        }
-    }
-
-    void onPlayerQuit(endstone::PlayerQuitEvent &event)
-    {
-        auto& player = event.getPlayer();
-        getLogger().info("Player quit: {}", player.getName());
-        
-        // Clean up player data when they leave
-        PlayerRegister::PlayerManager::unloadPlayer(&player);
+        // Clean up player data. Limbo players get their state back first, the
+        // journal written on close() only holds a lossy copy of it.
+        PlayerRegister::PlayerManager::restoreLimboPlayers();
+        PlayerRegister::PlayerManager::clearAllData();
+        PlayerRegister::SessionTickets::clear();
+        PlayerRegister::LimboJournal::close();
+        PlayerRegister::Log::stop();
     }
 
     void onServerLoad(endstone::ServerLoadEvent &event)
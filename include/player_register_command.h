@@ -5,7 +5,17 @@
 #include <endstone/endstone.hpp>
 #include <string>
 #include "account_manager.h"
-#include "database.h"
+#include "bulk_reset.h"
+#include "config.h"
+#include "limbo_journal.h"
+#include "log.h"
+#include "messages.h"
+#include "password_hasher.h"
+#include "pepper.h"
+#include "random.h"
+#include "rate_limiter.h"
+#include "session_tickets.h"
+#include "work_scheduler.h"
 
 class PlayerRegisterCommandExecutor : public endstone::CommandExecutor {
 public:
@@ -36,10 +46,22 @@ public:
             return handleResetPassword(sender, args);
         }
 
+        if (command.getName() == "resetpasswords") {
+            return handleResetPasswords(sender, args);
+        }
+
+        if (command.getName() == "rotatepepper") {
+            return handleRotatePepper(sender, args);
+        }
+
         if (command.getName() == "logout") {
             return handleLogout(sender, args);
         }
 
+        if (command.getName() == "authstats") {
+            return handleAuthStats(sender, args);
+        }
+
         return false;
     }
 
@@ -61,7 +83,7 @@ private:
         const std::string& confirmPassword = args[1];
 
         if (password != confirmPassword) {
-            sender.sendErrorMessage("Пароли не совпадают!");
+            player->sendMessage(PlayerRegister::msg(PlayerRegister::MsgId::PasswordsMismatch));
             return true;
         }
 
@@ -81,6 +103,12 @@ private:
             return true;
         }
 
+        // Checked before any file read or hashing so floods stay cheap
+        if (!PlayerRegister::RateLimiter::allowLogin(*player)) {
+            player->sendMessage(PlayerRegister::msg(PlayerRegister::MsgId::TooManyLoginAttempts));
+            return true;
+        }
+
         const std::string& password = args[0];
 
         return PlayerRegister::AccountManager::loginAccount(*player, player->getName(), password);
@@ -104,7 +132,7 @@ private:
         const std::string& confirmPassword = args[2];
 
         if (newPassword != confirmPassword) {
-            sender.sendErrorMessage("Новые пароли не совпадают!");
+            player->sendMessage(PlayerRegister::msg(PlayerRegister::MsgId::NewPasswordsMismatch));
             return true;
         }
 
@@ -129,12 +157,7 @@ private:
         if (action == "info") {
             PlayerRegister::AccountManager::showAccountInfo(*player);
         } else {
-            sender.sendMessage(endstone::ColorFormat::Yellow + "Команды управления аккаунтом:");
-            sender.sendMessage(endstone::ColorFormat::Gold + "/account - Показать информацию об аккаунте");
-            sender.sendMessage(endstone::ColorFormat::Gold + "/register <пароль> <подтверждение> - Создать аккаунт");
-            sender.sendMessage(endstone::ColorFormat::Gold + "/login <пароль> - Войти в аккаунт");
-            sender.sendMessage(endstone::ColorFormat::Gold + "/changepassword <старый> <новый> <подтверждение> - Сменить пароль");
-            sender.sendMessage(endstone::ColorFormat::Gold + "/logout - Выйти из аккаунта");
+            PlayerRegister::Messages::send(*player, PlayerRegister::MsgId::AccountCommands);
         }
 
         return true;
@@ -149,22 +172,113 @@ private:
         }
 
         if (args.size() < 1) {
-            sender.sendErrorMessage("Использование: /resetpassword <ник>");
+            PlayerRegister::Messages::send(sender, PlayerRegister::MsgId::ResetPasswordUsage);
             return true;
         }
 
         const std::string& username = args[0];
         
         // Generate a random password
-        std::string newPassword = std::to_string(rand() % 900000 + 100000); // 6-digit number
+        std::string newPassword = PlayerRegister::Random::digits(PlayerRegister::AccountManager::RESET_PASSWORD_DIGITS);
         
-        if (PlayerRegister::AccountManager::changePassword(username, newPassword)) {
-            sender.sendMessage(endstone::ColorFormat::Green + "Пароль для аккаунта '" + username + "' был сброшен на: " + newPassword);
+        // The result arrives a few ticks later, the sender is looked up again by then
+        std::optional<endstone::UUID> operatorId;
+        if (auto* player = sender.asPlayer()) {
+            operatorId = player->getUniqueId();
+        }
+        auto report = [operatorId, username, newPassword](bool reset) {
+            using PlayerRegister::MsgId;
+            const std::string& text = reset ? PlayerRegister::msg(MsgId::ResetPasswordDone, username, newPassword)
+                                            : PlayerRegister::msg(MsgId::ResetPasswordFailed, username);
+            if (!operatorId) {
+                if (auto* plugin = PlayerRegister::PlayerManager::getPlugin()) {
+                    plugin->getLogger().info("{}", text);
+                }
+            } else if (auto* player = PlayerRegister::PlayerManager::getPlayerByUUID(*operatorId)) {
+                player->sendMessage((reset ? endstone::ColorFormat::Green : endstone::ColorFormat::Red) + text);
+            }
+        };
+
+        if (!PlayerRegister::AccountManager::changePassword(username, newPassword, report)) {
+            PlayerRegister::Messages::send(sender, PlayerRegister::MsgId::ServerBusy);
+        }
+        return true;
+    }
+
+    bool handleResetPasswords(endstone::CommandSender &sender, const std::vector<std::string> &args)
+    {
+        if (!sender.hasPermission("endstone.command.op")) {
+            sender.sendErrorMessage("This command can only be used by operators!");
             return true;
-        } else {
-            sender.sendErrorMessage("Аккаунт '" + username + "' не найден!");
+        }
+
+        // Names and patterns may arrive as one message argument, split them up
+        std::vector<std::string> filters;
+        for (const auto& arg : args) {
+            std::string token;
+            for (char c : arg + " ") {
+                if (c == ' ' || c == ',') {
+                    if (!token.empty()) filters.push_back(token);
+                    token.clear();
+                } else {
+                    token += c;
+                }
+            }
+        }
+
+        if (filters.empty()) {
+            PlayerRegister::Messages::send(sender, PlayerRegister::MsgId::ResetPasswordsUsage);
+            return true;
+        }
+
+        PlayerRegister::BulkReset::start(sender, filters);
+        return true;
+    }
+
+    bool handleRotatePepper(endstone::CommandSender &sender, const std::vector<std::string> &args)
+    {
+        if (!sender.hasPermission("endstone.command.op")) {
+            sender.sendErrorMessage("This command can only be used by operators!");
+            return true;
+        }
+
+        if (PlayerRegister::Pepper::previousId() != 0) {
+            PlayerRegister::Messages::send(sender, PlayerRegister::MsgId::PepperRotationPending);
+            return true;
+        }
+
+        if (!PlayerRegister::Pepper::rotate()) {
+            PlayerRegister::Messages::send(sender, PlayerRegister::MsgId::PepperSaveFailed);
+            return true;
+        }
+
+        PlayerRegister::Messages::send(sender, PlayerRegister::MsgId::PepperRotated, PlayerRegister::Pepper::currentId(),
+                                       PlayerRegister::Config::getInstance().pepper_grace_days);
+        return true;
+    }
+
+    bool handleAuthStats(endstone::CommandSender &sender, const std::vector<std::string> &args)
+    {
+        if (!sender.hasPermission("endstone.command.op")) {
+            sender.sendErrorMessage("This command can only be used by operators!");
             return true;
         }
+
+        std::vector<std::string> lines;
+        PlayerRegister::AccountManager::describeStats(lines);
+        PlayerRegister::PasswordHasher::describeStats(lines);
+        PlayerRegister::PlayerManager::describeStats(lines);
+        PlayerRegister::AuthStateStats::describeStats(lines);
+        PlayerRegister::WorkScheduler::describeStats(lines);
+        PlayerRegister::LimboJournal::describeStats(lines);
+        PlayerRegister::Pepper::describeStats(lines);
+        PlayerRegister::SessionTickets::describeStats(lines);
+        PlayerRegister::RateLimiter::describeStats(lines);
+        PlayerRegister::Log::describeStats(lines);
+        for (const auto& line : lines) {
+            sender.sendMessage(line);
+        }
+        return true;
     }
 
     bool handleLogout(endstone::CommandSender &sender, const std::vector<std::string> &args)
@@ -175,14 +289,8 @@ private:
             return true;
         }
         
-        // Remove player data to logout
-        if (PlayerRegister::Database::removePlayer(PlayerRegister::PlayerManager::getId(player))) {
-            sender.sendMessage(endstone::ColorFormat::Green + "Успешный выход из аккаунта!");
-            PlayerRegister::PlayerManager::reconnect(player);
-        } else {
-            sender.sendErrorMessage("Вы не вошли в аккаунт!");
-        }
-
+        // The record is removed on the I/O pool, the answer follows a tick later
+        PlayerRegister::AccountManager::logout(*player);
         return true;
     }
 };
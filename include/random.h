@@ -0,0 +1,34 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace PlayerRegister {
+
+// ChaCha20-based CSPRNG for salts, fake UUIDs/XUIDs, reset passwords and
+// tokens. Every thread seeds its own key once from std::random_device and
+// serves requests from a refill buffer; the key is replaced from the
+// keystream on each refill, so earlier output can't be recovered later.
+class Random {
+public:
+    static void fill(uint8_t* out, size_t length);
+    static uint64_t next();
+
+    // Uniform in [0, bound) without modulo bias
+    static uint64_t uniform(uint64_t bound);
+
+    // Random decimal string of exactly count digits, first digit non-zero
+    static std::string digits(size_t count);
+
+    static void chachaBlock(const uint32_t key[8], uint32_t counter, const uint32_t nonce[3], uint8_t out[64]);
+
+private:
+    struct State;
+    static State& state();
+    static void refill(State& s);
+};
+
+} // namespace PlayerRegister
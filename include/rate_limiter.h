@@ -0,0 +1,56 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include <endstone/endstone.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace PlayerRegister {
+
+// Token-bucket limiter for /login attempts, keyed by client IP and by
+// account name. Buckets live in a fixed-size open-addressing table of
+// atomic words, so a check is O(1) and never touches the disk or a hash
+// pool. A bucket that has been idle long enough to refill completely can
+// be taken over by another key.
+class RateLimiter {
+public:
+    static void init();
+
+    // Consumes one token from both the IP and the account bucket
+    static bool allowLogin(endstone::Player& pl);
+
+    static uint64_t getRejected();
+    static uint64_t getOverflows();
+    static void describeStats(std::vector<std::string>& lines);
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> key{0};
+        std::atomic<uint64_t> state{0}; // last refill ms << 24 | milli-tokens
+    };
+
+    static constexpr size_t CAPACITY = 8192;
+    static constexpr size_t MAX_PROBES = 8;
+    static constexpr uint64_t TOKEN_BITS = 24;
+    static constexpr uint64_t TOKEN_MASK = (1ULL << TOKEN_BITS) - 1;
+
+    static bool consume(uint64_t key, uint64_t nowMs);
+    static uint64_t hashKey(char kind, std::string_view value);
+    static size_t homeSlot(uint64_t key);
+    static uint64_t nowMs();
+
+    static std::unique_ptr<Slot[]> table_;
+    static uint64_t burstMilli_;
+    static uint64_t refillPerSecondMilli_;
+    static std::chrono::steady_clock::time_point epoch_;
+    static std::atomic<uint64_t> rejected_;
+    static std::atomic<uint64_t> overflows_;
+};
+
+} // namespace PlayerRegister
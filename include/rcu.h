@@ -0,0 +1,154 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace PlayerRegister {
+
+namespace detail {
+
+struct alignas(64) EpochSlot {
+    static constexpr uint64_t IDLE = UINT64_MAX;
+
+    std::atomic<bool> used{false};
+    std::atomic<uint64_t> epoch{IDLE};
+};
+
+// A thread claims a slot on its first read and gives it back when it exits
+struct EpochThread {
+    EpochSlot* slot = nullptr;
+    bool claimed = false;
+    unsigned depth = 0;
+
+    ~EpochThread()
+    {
+        if (slot) slot->used.store(false);
+    }
+};
+
+} // namespace detail
+
+// Epoch-based reclamation. While a thread holds an Epoch::Guard it announces
+// the global epoch in a slot of its own; an object retired at epoch e is freed
+// once no active slot shows an epoch <= e. Entering and leaving are a load and
+// two stores, readers never block the publisher and never wait themselves.
+class Epoch {
+public:
+    // Everything loaded from an RcuCell stays alive while a guard exists; guards nest
+    class Guard {
+    public:
+        Guard() { enter(); }
+        ~Guard() { leave(); }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    // Starts a new epoch and returns the one that just ended
+    static uint64_t advance() { return global_.fetch_add(1); }
+
+    // True once no reader can still hold an object retired at epoch
+    static bool quiescent(uint64_t epoch)
+    {
+        if (overflow_.load() > 0) return false;
+        for (const auto& slot : slots_) {
+            uint64_t seen = slot.epoch.load();
+            if (seen != IDLE && seen <= epoch) return false;
+        }
+        return true;
+    }
+
+private:
+    static constexpr size_t SLOTS = 64;
+    static constexpr uint64_t IDLE = detail::EpochSlot::IDLE;
+
+    using Slot = detail::EpochSlot;
+    using ThreadState = detail::EpochThread;
+
+    static void enter()
+    {
+        ThreadState& state = thread_;
+        if (state.depth++ > 0) return;
+        if (!state.claimed) {
+            state.claimed = true;
+            state.slot = claim();
+        }
+        // Threads beyond SLOTS hold back all reclamation while they read
+        if (state.slot) {
+            state.slot->epoch.store(global_.load());
+        } else {
+            overflow_.fetch_add(1);
+        }
+    }
+
+    static void leave()
+    {
+        ThreadState& state = thread_;
+        if (--state.depth > 0) return;
+        if (state.slot) {
+            state.slot->epoch.store(IDLE);
+        } else {
+            overflow_.fetch_sub(1);
+        }
+    }
+
+    static Slot* claim()
+    {
+        for (auto& slot : slots_) {
+            bool expected = false;
+            if (slot.used.compare_exchange_strong(expected, true)) return &slot;
+        }
+        return nullptr;
+    }
+
+    static inline std::atomic<uint64_t> global_{1};
+    static inline std::atomic<int> overflow_{0};
+    static inline std::array<Slot, SLOTS> slots_;
+    static inline thread_local ThreadState thread_;
+};
+
+// Pointer to an immutable T. One thread publishes replacements, any thread
+// loads the current value under an Epoch::Guard. Replaced values are retired
+// and freed by later publish() or reclaim() calls once readers moved on.
+template <typename T>
+class RcuCell {
+public:
+    RcuCell() = default;
+    RcuCell(const RcuCell&) = delete;
+    RcuCell& operator=(const RcuCell&) = delete;
+
+    ~RcuCell() { delete current_.load(); }
+
+    // Valid until the caller's guard goes away; nullptr before the first publish
+    const T* load() const { return current_.load(); }
+
+    void publish(std::unique_ptr<const T> next)
+    {
+        const T* old = current_.exchange(next.release());
+        if (old) {
+            retired_.emplace_back(Epoch::advance(), std::unique_ptr<const T>(old));
+        }
+        reclaim();
+    }
+
+    void reclaim()
+    {
+        retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+                                      [](const auto& entry) { return Epoch::quiescent(entry.first); }),
+                       retired_.end());
+    }
+
+    size_t retired() const { return retired_.size(); }
+
+private:
+    std::atomic<const T*> current_{nullptr};
+    std::vector<std::pair<uint64_t, std::unique_ptr<const T>>> retired_; // publisher only
+};
+
+} // namespace PlayerRegister
@@ -0,0 +1,60 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include "hmac.h"
+
+#include <endstone/endstone.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace PlayerRegister {
+
+// Short-lived resume tickets issued when an authenticated player leaves.
+// A reconnect with the same UUID from the same IP before the ticket expires
+// is authenticated at join without limbo or password hashing.
+//
+// Tickets live in a fixed-size open-addressing table. The IP is not stored:
+// it is bound through an HMAC-SHA256 tag over UUID, IP and expiry, keyed
+// with a secret generated at startup. Each ticket also carries a keyed
+// digest of its account name, so an account's tickets can be revoked while
+// their holders are offline.
+class SessionTickets {
+public:
+    static void init();
+    static void clear();
+
+    static void issue(endstone::Player* pl, const std::string& account);
+    static bool redeem(endstone::Player* pl);
+    // Drops the player's ticket and refuses the one their next quit would issue
+    static void revoke(endstone::Player* pl);
+    // Drops every ticket issued for these accounts, returns how many
+    static size_t revokeAccounts(const std::unordered_set<std::string>& accounts);
+
+    static size_t size();
+    static void describeStats(std::vector<std::string>& lines);
+
+private:
+    struct Ticket {
+        std::array<uint8_t, 16> uuid{};
+        int64_t expiresAt = 0; // steady_clock seconds, 0 marks an empty slot
+        std::array<uint8_t, 16> tag{};
+        std::array<uint8_t, 8> account{};
+    };
+
+    static constexpr size_t MAX_PROBES = 16;
+
+    static std::array<uint8_t, 16> computeTag(const std::array<uint8_t, 16>& uuid, const std::string& ip, int64_t expiresAt);
+    static std::array<uint8_t, 8> accountKey(const std::string& account);
+    static size_t slotFor(const std::array<uint8_t, 16>& uuid);
+    static int64_t now();
+
+    static std::vector<Ticket> table_;
+    static KeyedHasher hasher_;
+    static std::unordered_set<std::string> revoked_;
+};
+
+} // namespace PlayerRegister
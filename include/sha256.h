@@ -4,24 +4,37 @@
 #define SHA256_H
 
 #include <string>
+#include <string_view>
 #include <array>
 #include <cstdint>
 
 class SHA256 {
 public:
-    SHA256();
+    // Legacy is the historical digest that stored passwords use; Standard is
+    // FIPS 180-4 SHA-256 for new keyed constructions such as HMAC.
+    enum class Variant { Legacy, Standard };
+
+    explicit SHA256(Variant variant = Variant::Legacy);
     void update(const uint8_t * data, size_t length);
     void update(const std::string &data);
     std::array<uint8_t, 32> digest();
 
     static std::string toString(const std::array<uint8_t, 32> & digest);
     static std::string digest_str(const std::string &data);
+    static std::array<uint8_t, 32> hash(const std::string &data);
+
+    // Same digest as hash() (or as the given variant), usable in constant
+    // expressions. The runtime path above stays the one used for passwords.
+    static constexpr std::array<uint8_t, 32> compileTimeHash(std::string_view data, Variant variant = Variant::Legacy);
+
+    struct ConstexprState;
 
 private:
     uint8_t  m_data[64];
     uint32_t m_blocklen;
     uint64_t m_bitlen;
     uint32_t m_state[8]; //A, B, C, D, E, F, G, H
+    Variant  m_variant;
 
     static constexpr std::array<uint32_t, 64> K = {
         0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,
@@ -47,9 +60,124 @@ private:
     static uint32_t majority(uint32_t a, uint32_t b, uint32_t c);
     static uint32_t sig0(uint32_t x);
     static uint32_t sig1(uint32_t x);
+    static uint32_t ep0(uint32_t x);
+    static uint32_t ep1(uint32_t x);
     void transform();
     void pad();
     void revert(std::array<uint8_t, 32> & hash);
 };
 
+// Byte-at-a-time mirror of update()/pad()/transform(). It must produce
+// exactly what the runtime class does. Variant::Legacy differs from FIPS
+// 180-4: the round function uses sig0/sig1 in place of the upper-case sigmas,
+// and pad() encodes the length after the padding bytes were added. Stored
+// account hashes depend on both, so the two paths keep them.
+struct SHA256::ConstexprState {
+    bool     standard = false;
+    uint8_t  data[64]{};
+    uint32_t blocklen = 0;
+    uint64_t bitlen = 0;
+    uint32_t state[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    static constexpr uint32_t rotr(uint32_t x, uint32_t n) {
+        return (x >> n) | (x << (32 - n));
+    }
+
+    static constexpr uint32_t sig0(uint32_t x) {
+        return rotr(x, 7) ^ rotr(x, 18) ^ (x >> 3);
+    }
+
+    static constexpr uint32_t sig1(uint32_t x) {
+        return rotr(x, 17) ^ rotr(x, 19) ^ (x >> 10);
+    }
+
+    static constexpr uint32_t ep0(uint32_t x) {
+        return rotr(x, 2) ^ rotr(x, 13) ^ rotr(x, 22);
+    }
+
+    static constexpr uint32_t ep1(uint32_t x) {
+        return rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25);
+    }
+
+    constexpr void transform() {
+        uint32_t w[64]{};
+        for (int i = 0, j = 0; i < 16; i++, j += 4) {
+            w[i] = (uint32_t(data[j]) << 24) | (uint32_t(data[j + 1]) << 16) | (uint32_t(data[j + 2]) << 8) | uint32_t(data[j + 3]);
+        }
+        for (int i = 16; i < 64; i++) {
+            w[i] = sig1(w[i - 2]) + w[i - 7] + sig0(w[i - 15]) + w[i - 16];
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; i++) {
+            uint32_t t1 = h + (standard ? ep1(e) : sig1(e)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+            uint32_t t2 = (standard ? ep0(a) : sig0(a)) + ((a & (b | c)) | (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+
+    constexpr void update(uint8_t byte) {
+        data[blocklen++] = byte;
+        if (blocklen == 64) {
+            transform();
+            bitlen += 512;
+            blocklen = 0;
+        }
+    }
+
+    constexpr void update(std::string_view input) {
+        for (char c : input) {
+            update(static_cast<uint8_t>(c));
+        }
+    }
+
+    constexpr std::array<uint8_t, 32> digest() {
+        const uint64_t messageBits = bitlen + blocklen * 8;
+        update(0x80);
+        while (blocklen != 56) {
+            update(0x00);
+        }
+        uint64_t length = standard ? messageBits : bitlen + blocklen * 8;
+        for (int i = 7; i >= 0; i--) {
+            update(static_cast<uint8_t>((length >> (i * 8)) & 0xFF));
+        }
+
+        std::array<uint8_t, 32> hash{};
+        for (int i = 0; i < 8; i++) {
+            hash[i * 4 + 0] = (state[i] >> 24) & 0xFF;
+            hash[i * 4 + 1] = (state[i] >> 16) & 0xFF;
+            hash[i * 4 + 2] = (state[i] >> 8) & 0xFF;
+            hash[i * 4 + 3] = state[i] & 0xFF;
+        }
+        return hash;
+    }
+};
+
+constexpr std::array<uint8_t, 32> SHA256::compileTimeHash(std::string_view input, Variant variant) {
+    ConstexprState ctx;
+    ctx.standard = variant == Variant::Standard;
+    ctx.update(input);
+    return ctx.digest();
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,124 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace PlayerRegister {
+
+// Index into a SlotMap plus the generation the slot had when the handle was
+// issued. Erasing bumps the generation, so old handles stop resolving.
+struct SlotHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool valid() const { return index != UINT32_MAX; }
+    bool operator==(const SlotHandle& other) const = default;
+};
+
+// Values are stored densely so iteration walks one contiguous vector.
+// Lookups go through a slot table that points into the dense array; erase
+// moves the last value into the hole and repoints its slot.
+template <typename T>
+class SlotMap {
+public:
+    using Handle = SlotHandle;
+
+    Handle insert(T value)
+    {
+        uint32_t index;
+        if (freeHead_ != UINT32_MAX) {
+            index = freeHead_;
+            freeHead_ = slots_[index].dense;
+        } else {
+            index = static_cast<uint32_t>(slots_.size());
+            slots_.push_back(Slot{});
+        }
+
+        slots_[index].dense = static_cast<uint32_t>(values_.size());
+        values_.push_back(std::move(value));
+        owners_.push_back(index);
+        return Handle{index, slots_[index].generation};
+    }
+
+    bool erase(Handle handle)
+    {
+        if (!contains(handle)) return false;
+
+        Slot& slot = slots_[handle.index];
+        uint32_t hole = slot.dense;
+        uint32_t last = static_cast<uint32_t>(values_.size() - 1);
+        if (hole != last) {
+            values_[hole] = std::move(values_[last]);
+            owners_[hole] = owners_[last];
+            slots_[owners_[hole]].dense = hole;
+        }
+        values_.pop_back();
+        owners_.pop_back();
+
+        slot.generation++;
+        slot.dense = freeHead_;
+        freeHead_ = handle.index;
+        return true;
+    }
+
+    bool contains(Handle handle) const
+    {
+        // Free slots always carry a newer generation than any handle issued for them
+        return handle.index < slots_.size() && slots_[handle.index].generation == handle.generation;
+    }
+
+    T* get(Handle handle)
+    {
+        return contains(handle) ? &values_[slots_[handle.index].dense] : nullptr;
+    }
+
+    const T* get(Handle handle) const
+    {
+        return contains(handle) ? &values_[slots_[handle.index].dense] : nullptr;
+    }
+
+    // Handle of the value at a position in the dense array
+    Handle handleAt(size_t position) const
+    {
+        uint32_t index = owners_[position];
+        return Handle{index, slots_[index].generation};
+    }
+
+    void clear()
+    {
+        // Keep slot generations so handles issued before the clear stay stale
+        values_.clear();
+        owners_.clear();
+        freeHead_ = UINT32_MAX;
+        for (uint32_t i = static_cast<uint32_t>(slots_.size()); i-- > 0;) {
+            slots_[i].generation++;
+            slots_[i].dense = freeHead_;
+            freeHead_ = i;
+        }
+    }
+
+    size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+
+    typename std::vector<T>::iterator begin() { return values_.begin(); }
+    typename std::vector<T>::iterator end() { return values_.end(); }
+    typename std::vector<T>::const_iterator begin() const { return values_.begin(); }
+    typename std::vector<T>::const_iterator end() const { return values_.end(); }
+
+private:
+    struct Slot {
+        uint32_t dense = UINT32_MAX; // position in values_, or next free slot
+        uint32_t generation = 0;
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<T> values_;
+    std::vector<uint32_t> owners_; // slot index of each dense value
+    uint32_t freeHead_ = UINT32_MAX;
+};
+
+} // namespace PlayerRegister
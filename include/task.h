@@ -0,0 +1,128 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include "log.h"
+#include "work_scheduler.h"
+#include "worker_pool.h"
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace PlayerRegister {
+
+// Fire-and-forget coroutine for flows that hop between the server thread and
+// the worker pools. The body starts right away on the calling thread, moves
+// with the awaitables below and frees its frame when it returns. Nothing can
+// await a Task; results go back to players through the main thread.
+class Task {
+public:
+    struct promise_type {
+        Task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept
+        {
+            try {
+                throw;
+            } catch (const std::exception& e) {
+                LOG_ERROR("task.failed", {"error", e.what()});
+            } catch (...) {
+                LOG_ERROR("task.failed", {"error", "unknown"});
+            }
+        }
+    };
+};
+
+namespace detail {
+
+// Owns a suspended coroutine until it is resumed. A frame whose job or
+// completion is dropped (pool shut down, scheduler stopped) is destroyed
+// together with it instead of leaking.
+class Resumption {
+public:
+    explicit Resumption(std::coroutine_handle<> handle) : handle_(handle) {}
+    Resumption(const Resumption&) = delete;
+    Resumption& operator=(const Resumption&) = delete;
+
+    ~Resumption()
+    {
+        if (handle_) handle_.destroy();
+    }
+
+    void resume() { std::exchange(handle_, nullptr).resume(); }
+    void release() { handle_ = nullptr; }
+
+private:
+    std::coroutine_handle<> handle_;
+};
+
+} // namespace detail
+
+// co_await onPool(pool) continues the coroutine on one of the pool's workers.
+// It yields false and keeps running on the current thread when the pool is
+// full or shut down; onPoolUnbounded(pool) only fails after shutdown.
+class PoolAwaiter {
+public:
+    explicit PoolAwaiter(WorkerPool* pool, bool bounded = true) : pool_(pool), bounded_(bounded) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        // The worker may resume the frame before this returns, don't touch members after submit
+        auto resumption = std::make_shared<detail::Resumption>(handle);
+        auto job = [resumption]() { resumption->resume(); };
+        if (pool_ && (bounded_ ? pool_->submit(job) : pool_->submitUnbounded(job))) {
+            return true;
+        }
+        resumption->release();
+        rejected_ = true;
+        return false;
+    }
+
+    bool await_resume() const noexcept { return !rejected_; }
+
+private:
+    WorkerPool* pool_;
+    bool bounded_;
+    bool rejected_ = false;
+};
+
+// co_await nextTick(queue) continues the coroutine on the server thread when
+// the WorkScheduler reaches it, at the earliest on the next tick.
+class TickAwaiter {
+public:
+    explicit TickAwaiter(WorkQueue queue) : queue_(queue) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        auto resumption = std::make_shared<detail::Resumption>(handle);
+        WorkScheduler::post(queue_, [resumption]() { resumption->resume(); });
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    WorkQueue queue_;
+};
+
+inline PoolAwaiter onPool(WorkerPool* pool) {
+    return PoolAwaiter(pool);
+}
+
+inline PoolAwaiter onPoolUnbounded(WorkerPool* pool) {
+    return PoolAwaiter(pool, false);
+}
+
+inline TickAwaiter nextTick(WorkQueue queue = WorkQueue::Auth) {
+    return TickAwaiter(queue);
+}
+
+} // namespace PlayerRegister
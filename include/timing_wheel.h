@@ -0,0 +1,179 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include "slot_map.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PlayerRegister {
+
+// Hierarchical timing wheel counted in server ticks. Four levels of 64 slots
+// cover about nine days; timers live in a node pool and are linked into
+// per-slot lists, so schedule and cancel are O(1) and advancing one tick only
+// touches the current slot (plus a cascade every 64 ticks).
+// Each timer carries an owner handle and a small kind tag instead of a
+// callback, the caller decides what a firing means.
+class TimingWheel {
+public:
+    using TimerId = SlotHandle;
+
+    static constexpr unsigned BITS = 6;
+    static constexpr unsigned SLOTS = 1u << BITS;
+    static constexpr unsigned LEVELS = 4;
+    // Keeps the top-level slot of a deadline distinct from the current one
+    static constexpr uint64_t MAX_DELAY = (1ull << (BITS * LEVELS)) - (1ull << (BITS * (LEVELS - 1)));
+
+    TimingWheel() { heads_.fill(NONE); }
+
+    TimerId schedule(uint64_t delayTicks, SlotHandle owner, uint8_t kind)
+    {
+        uint32_t index;
+        if (free_ != NONE) {
+            index = free_;
+            free_ = nodes_[index].next;
+        } else {
+            index = static_cast<uint32_t>(nodes_.size());
+            nodes_.push_back(Node{});
+        }
+
+        Node& node = nodes_[index];
+        node.deadline = now_ + std::clamp<uint64_t>(delayTicks, 1, MAX_DELAY);
+        node.owner = owner;
+        node.kind = kind;
+        node.active = true;
+        link(index);
+        size_++;
+        return TimerId{index, node.generation};
+    }
+
+    bool cancel(TimerId id)
+    {
+        if (!id.valid() || id.index >= nodes_.size()) return false;
+        Node& node = nodes_[id.index];
+        if (!node.active || node.generation != id.generation) return false;
+        unlink(id.index);
+        release(id.index);
+        return true;
+    }
+
+    // Moves time forward one tick and calls fire(owner, kind) for every timer
+    // that is due. Callbacks may schedule and cancel freely.
+    template <typename Fn>
+    void advance(Fn&& fire)
+    {
+        now_++;
+        for (unsigned level = 1; level < LEVELS; level++) {
+            if ((now_ & ((1ull << (BITS * level)) - 1)) != 0) break;
+            cascade(level * SLOTS + ((now_ >> (BITS * level)) & (SLOTS - 1)));
+        }
+
+        uint32_t& head = heads_[now_ & (SLOTS - 1)];
+        while (head != NONE) {
+            uint32_t index = head;
+            unlink(index);
+            SlotHandle owner = nodes_[index].owner;
+            uint8_t kind = nodes_[index].kind;
+            release(index);
+            fire(owner, kind);
+        }
+    }
+
+    void clear()
+    {
+        // Keep node generations so ids issued before the clear stay stale
+        heads_.fill(NONE);
+        free_ = NONE;
+        for (uint32_t i = static_cast<uint32_t>(nodes_.size()); i-- > 0;) {
+            Node& node = nodes_[i];
+            node.active = false;
+            node.generation++;
+            node.prev = NONE;
+            node.next = free_;
+            free_ = i;
+        }
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    uint64_t now() const { return now_; }
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Node {
+        uint64_t deadline = 0;
+        SlotHandle owner;
+        uint32_t generation = 0;
+        uint32_t prev = NONE;
+        uint32_t next = NONE;
+        uint16_t bucket = 0;
+        uint8_t kind = 0;
+        bool active = false;
+    };
+
+    // The level is the highest 6-bit group where deadline and now differ,
+    // so the timer is cascaded down exactly when now reaches that group
+    unsigned bucketFor(uint64_t deadline) const
+    {
+        uint64_t diff = deadline ^ now_;
+        unsigned level = diff == 0 ? 0 : (std::bit_width(diff) - 1) / BITS;
+        level = std::min(level, LEVELS - 1);
+        return level * SLOTS + ((deadline >> (BITS * level)) & (SLOTS - 1));
+    }
+
+    void link(uint32_t index)
+    {
+        Node& node = nodes_[index];
+        node.bucket = static_cast<uint16_t>(bucketFor(node.deadline));
+        node.prev = NONE;
+        node.next = heads_[node.bucket];
+        if (node.next != NONE) nodes_[node.next].prev = index;
+        heads_[node.bucket] = index;
+    }
+
+    void unlink(uint32_t index)
+    {
+        Node& node = nodes_[index];
+        if (node.prev != NONE) {
+            nodes_[node.prev].next = node.next;
+        } else {
+            heads_[node.bucket] = node.next;
+        }
+        if (node.next != NONE) nodes_[node.next].prev = node.prev;
+    }
+
+    void release(uint32_t index)
+    {
+        Node& node = nodes_[index];
+        node.active = false;
+        node.generation++;
+        node.next = free_;
+        free_ = index;
+        size_--;
+    }
+
+    void cascade(unsigned bucket)
+    {
+        uint32_t index = heads_[bucket];
+        heads_[bucket] = NONE;
+        while (index != NONE) {
+            uint32_t next = nodes_[index].next;
+            link(index);
+            index = next;
+        }
+    }
+
+    std::vector<Node> nodes_;
+    std::array<uint32_t, LEVELS * SLOTS> heads_;
+    uint32_t free_ = NONE;
+    size_t size_ = 0;
+    uint64_t now_ = 0;
+};
+
+} // namespace PlayerRegister
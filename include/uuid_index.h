@@ -0,0 +1,119 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include "slot_map.h"
+
+#include <endstone/endstone.hpp>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace PlayerRegister {
+
+// Open-addressing UUID -> SlotHandle table with linear probing. Entries sit
+// inline in one vector and deletion shifts the probe run back, so there are
+// no tombstones and no per-entry allocations.
+class UuidIndex {
+public:
+    SlotHandle find(const endstone::UUID& uuid) const
+    {
+        if (entries_.empty()) return SlotHandle{};
+        for (size_t i = bucket(uuid);; i = (i + 1) & mask()) {
+            const Entry& entry = entries_[i];
+            if (!entry.handle.valid()) return SlotHandle{};
+            if (same(entry.uuid, uuid)) return entry.handle;
+        }
+    }
+
+    void insert(const endstone::UUID& uuid, SlotHandle handle)
+    {
+        if ((size_ + 1) * 2 > entries_.size()) {
+            grow();
+        }
+        for (size_t i = bucket(uuid);; i = (i + 1) & mask()) {
+            Entry& entry = entries_[i];
+            if (!entry.handle.valid()) {
+                entry.uuid = uuid;
+                entry.handle = handle;
+                size_++;
+                return;
+            }
+            if (same(entry.uuid, uuid)) {
+                entry.handle = handle;
+                return;
+            }
+        }
+    }
+
+    bool erase(const endstone::UUID& uuid)
+    {
+        if (entries_.empty()) return false;
+        size_t i = bucket(uuid);
+        while (true) {
+            if (!entries_[i].handle.valid()) return false;
+            if (same(entries_[i].uuid, uuid)) break;
+            i = (i + 1) & mask();
+        }
+
+        // Pull later entries of the run back into the hole if their home allows it
+        size_t hole = i;
+        for (size_t j = (i + 1) & mask(); entries_[j].handle.valid(); j = (j + 1) & mask()) {
+            size_t home = bucket(entries_[j].uuid);
+            if (((j - home) & mask()) >= ((j - hole) & mask())) {
+                entries_[hole] = entries_[j];
+                hole = j;
+            }
+        }
+        entries_[hole] = Entry{};
+        size_--;
+        return true;
+    }
+
+    void clear()
+    {
+        entries_.assign(entries_.size(), Entry{});
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+
+private:
+    struct Entry {
+        endstone::UUID uuid{};
+        SlotHandle handle;
+    };
+
+    static bool same(const endstone::UUID& a, const endstone::UUID& b)
+    {
+        return std::memcmp(a.data, b.data, sizeof(a.data)) == 0;
+    }
+
+    size_t mask() const { return entries_.size() - 1; }
+
+    size_t bucket(const endstone::UUID& uuid) const
+    {
+        // Player UUIDs are random enough that folding the two halves spreads well
+        uint64_t lo, hi;
+        std::memcpy(&lo, uuid.data, sizeof(lo));
+        std::memcpy(&hi, uuid.data + 8, sizeof(hi));
+        uint64_t h = (lo ^ hi) * 0x9e3779b97f4a7c15ULL;
+        return static_cast<size_t>(h >> 32) & mask();
+    }
+
+    void grow()
+    {
+        std::vector<Entry> old;
+        old.swap(entries_);
+        entries_.assign(old.empty() ? 64 : old.size() * 2, Entry{});
+        size_ = 0;
+        for (const auto& entry : old) {
+            if (entry.handle.valid()) insert(entry.uuid, entry.handle);
+        }
+    }
+
+    std::vector<Entry> entries_;
+    size_t size_ = 0;
+};
+
+} // namespace PlayerRegister
@@ -0,0 +1,78 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include <endstone/endstone.hpp>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace PlayerRegister {
+
+// Queues in priority order, earlier queues are always drained first
+enum class WorkQueue : uint8_t {
+    Auth,         // login/register completions, players are waiting on these
+    Persistence,  // account writes that are not on a player's critical path
+    Reminders,    // chat and title reminders for players in limbo
+    Housekeeping, // retries and anything else that can wait
+    Count
+};
+
+// Runs all deferred plugin work on the server thread from one repeating task.
+// Each tick first runs the registered tick hooks, then takes work from the
+// queues in priority order until tick_budget_us is spent; whatever is left
+// carries over to the next tick. post() may be called from any thread.
+class WorkScheduler {
+public:
+    using Work = std::function<void()>;
+
+    struct QueueStats {
+        size_t pending = 0;
+        uint64_t completed = 0;
+        uint64_t avgLatencyUs = 0;
+        uint64_t maxLatencyUs = 0;
+    };
+
+    static void start(endstone::Plugin& plugin);
+    static void stop();
+    static void addTickHook(void (*hook)());
+    static void post(WorkQueue queue, Work work);
+
+    static QueueStats getStats(WorkQueue queue);
+    static uint64_t getLastTickUs();
+    static uint64_t getMaxTickUs();
+    static uint64_t getCarriedTicks();
+    static void describeStats(std::vector<std::string>& lines);
+
+private:
+    struct Item {
+        Work work;
+        std::chrono::steady_clock::time_point posted;
+    };
+
+    struct Queue {
+        std::deque<Item> ready; // server thread only
+        uint64_t completed = 0;
+        uint64_t totalLatencyUs = 0;
+        uint64_t maxLatencyUs = 0;
+    };
+
+    static void tick();
+
+    static std::shared_ptr<endstone::Task> task_;
+    static std::vector<void (*)()> hooks_;
+    static std::mutex mutex_;
+    static std::array<std::vector<Item>, static_cast<size_t>(WorkQueue::Count)> incoming_;
+    static std::array<Queue, static_cast<size_t>(WorkQueue::Count)> queues_;
+    static uint64_t lastTickUs_;
+    static uint64_t maxTickUs_;
+    static uint64_t carriedTicks_;
+};
+
+} // namespace PlayerRegister
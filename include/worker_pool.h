@@ -0,0 +1,93 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#pragma once
+
+#include "work_scheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace PlayerRegister {
+
+// Bounded pool of worker threads. Jobs run off the server thread and their
+// results are handed back to the main thread through WorkScheduler::post.
+class WorkerPool {
+public:
+    using Job = std::function<void()>;
+
+    struct Stats {
+        size_t threads = 0;
+        size_t queued = 0;
+        size_t capacity = 0;
+        uint64_t submitted = 0;
+        uint64_t rejected = 0;
+        uint64_t completed = 0;
+        uint64_t avgWaitUs = 0;
+        uint64_t avgRunUs = 0;
+        uint64_t maxLatencyUs = 0;
+    };
+
+    WorkerPool(std::string name, size_t threads, size_t capacity);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Returns false without queuing anything when the queue is full
+    bool submit(Job job);
+    // Queues past the capacity, for follow-up work that must not be dropped.
+    // Returns false only once the pool is shutting down.
+    bool submitUnbounded(Job job);
+
+    // Runs work on a worker and passes its result to done on the main thread
+    template <typename Work, typename Done>
+    bool submit(Work work, Done done, WorkQueue queue = WorkQueue::Auth)
+    {
+        auto state = std::make_shared<std::pair<Work, Done>>(std::move(work), std::move(done));
+        return submit([state, queue]() {
+            auto result = std::make_shared<decltype(state->first())>(state->first());
+            WorkScheduler::post(queue, [state, result]() { state->second(std::move(*result)); });
+        });
+    }
+
+    // Stops taking jobs. Queued jobs are dropped, or run first with drain
+    // set, which pools holding writes that must not be lost use.
+    void shutdown(bool drain = false);
+    Stats getStats() const;
+    const std::string& getName() const { return name_; }
+
+private:
+    struct Entry {
+        Job job;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    bool enqueue(Job job, bool bounded);
+    void workerLoop();
+
+    std::string name_;
+    size_t capacity_;
+    std::vector<std::thread> threads_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Entry> queue_;
+    bool stopping_ = false;
+
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> totalWaitUs_{0};
+    std::atomic<uint64_t> totalRunUs_{0};
+    std::atomic<uint64_t> maxLatencyUs_{0};
+};
+
+} // namespace PlayerRegister
@@ -2,16 +2,23 @@
 
 #include "account_manager.h"
 
-#include "sha256.h"
 #include "config.h"
+#include "password_hasher.h"
+#include "random.h"
 #include "database.h"
+#include "messages.h"
+#include "session_tickets.h"
 #include <endstone/endstone.hpp>
 #include <algorithm>
-#include <random>
 #include <sstream>
 
 namespace PlayerRegister {
 
+std::unique_ptr<WorkerPool> AccountManager::hashPool_;
+std::unique_ptr<WorkerPool> AccountManager::ioPool_;
+std::mutex AccountManager::inFlightMutex_;
+std::unordered_set<std::string> AccountManager::inFlight_;
+
 void AccountManager::trimString(std::string& s) {
     s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char ch) { return !std::isspace(ch); }));
     s.erase(std::find_if(s.rbegin(), s.rend(), [](unsigned char ch) { return !std::isspace(ch); }).base(), s.end());
@@ -25,52 +32,141 @@ bool AccountManager::validateUsername(const std::string& username) {
     return username.length() >= 3 && username.length() <= 16;
 }
 
+void AccountManager::init() {
+    const auto& config = Config::getInstance();
+    PasswordHasher::init();
+    hashPool_ = std::make_unique<WorkerPool>("hash", config.hash_threads, config.hash_queue_capacity);
+    ioPool_ = std::make_unique<WorkerPool>("io", 1, config.io_queue_capacity);
+}
+
+void AccountManager::shutdown() {
+    // Queued hashes are dropped, which destroys the flows waiting on them.
+    // The I/O pool is drained instead: writes queued through onIoPoolForWrite
+    // must reach the disk, and flows they resume can no longer hash.
+    if (hashPool_) {
+        hashPool_->shutdown();
+        hashPool_.reset();
+    }
+    if (ioPool_) {
+        ioPool_->shutdown(true);
+        ioPool_.reset();
+    }
+    std::lock_guard<std::mutex> lock(inFlightMutex_);
+    inFlight_.clear();
+}
+
+WorkerPool::Stats AccountManager::getHashPoolStats() {
+    return hashPool_ ? hashPool_->getStats() : WorkerPool::Stats{};
+}
+
+WorkerPool::Stats AccountManager::getIoPoolStats() {
+    return ioPool_ ? ioPool_->getStats() : WorkerPool::Stats{};
+}
+
+void AccountManager::describeStats(std::vector<std::string>& lines) {
+    auto hash = getHashPoolStats();
+    lines.push_back(msg(MsgId::StatsHeader));
+    lines.push_back(msg(MsgId::StatsHashThreads, hash.threads, hash.queued, hash.capacity));
+    lines.push_back(msg(MsgId::StatsHashCounts, hash.submitted, hash.rejected, hash.completed));
+    lines.push_back(msg(MsgId::StatsHashLatency, hash.avgWaitUs, hash.avgRunUs, hash.maxLatencyUs));
+    auto io = getIoPoolStats();
+    lines.push_back(msg(MsgId::StatsIoPool, io.queued, io.capacity, io.completed, io.rejected, io.maxLatencyUs));
+}
+
+WorkerPool* AccountManager::getHashPool() {
+    return hashPool_.get();
+}
+
+WorkerPool* AccountManager::getIoPool() {
+    return ioPool_.get();
+}
+
+bool AccountManager::beginRequest(endstone::Player& pl) {
+    if (!hashPool_ || !ioPool_) {
+        return false;
+    }
+    bool inserted;
+    {
+        std::lock_guard<std::mutex> lock(inFlightMutex_);
+        inserted = inFlight_.insert(PlayerManager::getId(&pl)).second;
+    }
+    if (!inserted) {
+        pl.sendMessage(msg(MsgId::RequestPending));
+        return false;
+    }
+    return true;
+}
+
+void AccountManager::endRequest(const std::string& id) {
+    std::lock_guard<std::mutex> lock(inFlightMutex_);
+    inFlight_.erase(id);
+}
+
+// The player a flow was started for, or nullptr once they left or their slot was reused
+static endstone::Player* findPlayer(const endstone::UUID& uuid, PlayerManager::Handle handle) {
+    auto* player = PlayerManager::getPlayerByUUID(uuid);
+    return player && PlayerManager::get(handle) ? player : nullptr;
+}
+
+// A failed login or registration puts the player back into limbo
+static void returnToLimbo(endstone::Player* player) {
+    if (PlayerManager::getAuthState(player) == AuthState::Authenticating) {
+        PlayerManager::transition(player, AuthState::Limbo);
+    }
+}
+
+static void sendFailure(const endstone::UUID& uuid, PlayerManager::Handle handle, MsgId id) {
+    if (auto* player = findPlayer(uuid, handle)) {
+        returnToLimbo(player);
+        player->sendMessage(msg(id));
+    }
+}
+
+static void sendBusyMessage(const endstone::UUID& uuid, PlayerManager::Handle handle) {
+    sendFailure(uuid, handle, MsgId::ServerBusy);
+}
+
+// Online records are move-only, flows that write one back take a copy
+static PlayerData copyRecord(const PlayerData& data) {
+    PlayerData copy;
+    copy.id = data.id;
+    copy.uuid = data.uuid;
+    copy.name = data.name;
+    copy.password = data.password;
+    copy.accounts = data.accounts;
+    copy.fakeUUID = data.fakeUUID;
+    copy.fakeXUID = data.fakeXUID;
+    copy.fakeDBkey = data.fakeDBkey;
+    return copy;
+}
+
 bool AccountManager::createAccount(endstone::Player& pl, const std::string& name, const std::string& password, bool create_new) {
     std::string trimmedPassword = password;
     trimString(trimmedPassword);
 
     if (!validatePassword(trimmedPassword)) {
-        pl.sendMessage(endstone::ColorFormat::Red + "Пароль должен быть не менее 4 символов!");
+        pl.sendMessage(msg(MsgId::PasswordTooShort));
         return false;
     }
 
-    // Check if account with player name already exists
     PlayerData data;
     data.id = PlayerManager::getId(&pl);
     data.name = pl.getName(); // Use player's actual name instead of provided name
-    Database::loadAsAccount(data);
-    
-    if (data.valid) {
-        pl.sendMessage(endstone::ColorFormat::Red + "Аккаунт с таким никнеймом (" + pl.getName() + ") уже существует.");
-        return false;
-    }
-
     data.accounts = PlayerManager::getPlayerData(&pl).accounts + 1;
     
     // Check max accounts limit from config
     const int max_accounts = Config::getInstance().max_accounts;
     if (data.accounts > max_accounts) {
-        pl.sendMessage(endstone::ColorFormat::Red + "Вы уже создали максимальное количество аккаунтов (" + std::to_string(max_accounts) + ")!");
+        pl.sendMessage(msg(MsgId::MaxAccounts, max_accounts));
         return false;
     }
 
-    // Hash the password using SHA256
-    data.password = SHA256::digest_str(trimmedPassword);
-    
     if (create_new) {
-        // Generate a random UUID using a simple method
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<uint64_t> dis;
-        uint64_t high = dis(gen);
-        uint64_t low = dis(gen);
-        
-        // Create UUID by filling the byte array
+        // Generate a random (version 4) UUID
         endstone::UUID uuid;
-        for (int i = 0; i < 8; i++) {
-            uuid.data[i] = (high >> (8 * (7 - i))) & 0xFF;
-            uuid.data[8 + i] = (low >> (8 * (7 - i))) & 0xFF;
-        }
+        Random::fill(uuid.data, sizeof(uuid.data));
+        uuid.data[6] = (uuid.data[6] & 0x0F) | 0x40;
+        uuid.data[8] = (uuid.data[8] & 0x3F) | 0x80;
         data.fakeUUID = uuid;
         data.fakeDBkey = "player_server_" + data.fakeUUID.str();
     } else {
@@ -81,89 +177,252 @@ bool AccountManager::createAccount(endstone::Player& pl, const std::string& name
     }
 
     if (data.fakeXUID.empty()) {
-        data.fakeXUID = std::to_string(rand()); // Simple random number as placeholder
+        data.fakeXUID = Random::digits(16); // XUID-shaped placeholder
+    }
+
+    if (!beginRequest(pl)) {
+        return false;
+    }
+
+    if (PlayerManager::getAuthState(&pl) == AuthState::Limbo) {
+        PlayerManager::transition(&pl, AuthState::Authenticating);
+    }
+    createFlow(pl.getUniqueId(), PlayerManager::getHandle(&pl), std::move(data), std::move(trimmedPassword));
+    return true;
+}
+
+Task AccountManager::createFlow(endstone::UUID uuid, PlayerManager::Handle handle, PlayerData data, std::string password) {
+    RequestScope request(data.id);
+    uint64_t since = PlayerManager::getSnapshotVersion();
+
+    // Check if account with player name already exists
+    if (!co_await onIoPool()) {
+        co_await nextTick();
+        sendBusyMessage(uuid, handle);
+        co_return;
     }
+    PlayerData existing;
+    existing.name = data.name;
+    if (Database::loadAsAccount(existing)) {
+        co_await nextTick();
+        if (auto* player = findPlayer(uuid, handle)) {
+            returnToLimbo(player);
+            player->sendMessage(msg(MsgId::AccountExists, player->getName()));
+        }
+        co_return;
+    }
+
+    // Don't spend a hash on someone who already left
+    if (PlayerManager::hasLeft(uuid, since)) co_return;
 
-    data.valid = true;
-    data.isRegistered = true;
-    data.isAuthenticated = true;
+    if (!co_await onHashPool()) {
+        co_await nextTick();
+        sendBusyMessage(uuid, handle);
+        co_return;
+    }
+    auto hashed = PasswordHasher::hash(password);
+    if (!hashed) {
+        co_await nextTick();
+        sendFailure(uuid, handle, MsgId::HashFailed);
+        co_return;
+    }
+    data.password = *hashed;
+
+    if (!co_await onIoPoolForWrite()) co_return;
     Database::storeAsAccount(data);
     Database::storeAsPlayer(data);
-    
-    pl.sendMessage(endstone::ColorFormat::Green + "Аккаунт успешно создан!");
-    
+
+    co_await nextTick();
+    auto* player = findPlayer(uuid, handle);
+    if (!player) co_return;
+
+    player->sendMessage(msg(MsgId::AccountCreated));
+
     // Complete authorization process - this will teleport player back
-    PlayerManager::completeAuthorizationProcess(&pl);
-    
+    PlayerManager::completeAuthorizationProcess(player);
+
     // Update player data to mark as authenticated
-    PlayerManager::setPlayerData(&pl, data);
-    
-    // No need for reconnect since we're already authenticated
-    
-    return true;
+    PlayerManager::setPlayerData(player, std::move(data));
+    PlayerManager::setAuthFlags(player, AUTH_VALID | AUTH_REGISTERED | AUTH_AUTHENTICATED);
 }
 
 bool AccountManager::loginAccount(endstone::Player& pl, const std::string& name, const std::string& password) {
     std::string trimmedPassword = password;
     trimString(trimmedPassword);
 
+    if (!beginRequest(pl)) {
+        return false;
+    }
+
     PlayerData data;
     data.id = PlayerManager::getId(&pl);
     data.name = pl.getName(); // Use player's actual name
-    Database::loadAsAccount(data);
 
-    if (!data.valid) {
-        pl.sendMessage(endstone::ColorFormat::Red + "Аккаунт не найден!");
-        return false;
+    if (PlayerManager::getAuthState(&pl) == AuthState::Limbo) {
+        PlayerManager::transition(&pl, AuthState::Authenticating);
+    }
+    loginFlow(pl.getUniqueId(), PlayerManager::getHandle(&pl), std::move(data), std::move(trimmedPassword));
+    return true;
+}
+
+Task AccountManager::loginFlow(endstone::UUID uuid, PlayerManager::Handle handle, PlayerData data, std::string password) {
+    RequestScope request(data.id);
+    uint64_t since = PlayerManager::getSnapshotVersion();
+
+    if (!co_await onIoPool()) {
+        co_await nextTick();
+        sendBusyMessage(uuid, handle);
+        co_return;
+    }
+    if (!Database::loadAsAccount(data)) {
+        co_await nextTick();
+        if (auto* player = findPlayer(uuid, handle)) {
+            returnToLimbo(player);
+            player->sendMessage(msg(MsgId::AccountNotFound));
+        }
+        co_return;
     }
 
-    // Hash the provided password and compare with stored hash
-    std::string hashedPassword = SHA256::digest_str(trimmedPassword);
-    if (data.password != hashedPassword) {
-        pl.sendMessage(endstone::ColorFormat::Red + "Неверный пароль!");
-        return false;
+    if (PlayerManager::hasLeft(uuid, since)) co_return;
+
+    // Credentials from an old algorithm or pepper key are rehashed while we are on the hash pool
+    if (!co_await onHashPool()) {
+        co_await nextTick();
+        sendBusyMessage(uuid, handle);
+        co_return;
+    }
+    bool matches = PasswordHasher::verify(password, data.password);
+    bool upgraded = matches && PasswordHasher::needsRehash(data.password);
+    if (upgraded) {
+        // A failed rehash keeps the old credential, it verified just now
+        auto hashed = PasswordHasher::hash(password);
+        upgraded = hashed.has_value();
+        if (hashed) {
+            data.password = *hashed;
+        }
     }
 
-    data.isRegistered = true;
-    data.isAuthenticated = true;
-    Database::storeAsPlayer(data);
-    PlayerManager::setPlayerData(&pl, data);
-    
-    pl.sendMessage(endstone::ColorFormat::Green + "Успешный вход в систему!");
-    
+    if (matches) {
+        if (!co_await onIoPoolForWrite()) co_return;
+        if (upgraded) {
+            Database::storeAsAccount(data);
+        }
+        Database::storeAsPlayer(data);
+    }
+
+    co_await nextTick();
+    auto* player = findPlayer(uuid, handle);
+    if (!player) co_return;
+
+    if (!matches) {
+        returnToLimbo(player);
+        player->sendMessage(msg(MsgId::WrongPassword));
+        co_return;
+    }
+
+    PlayerManager::setPlayerData(player, std::move(data));
+    PlayerManager::setAuthFlags(player, AUTH_VALID | AUTH_REGISTERED);
+
+    player->sendMessage(msg(MsgId::LoginSuccess));
+
     // Complete authorization process - this will teleport player back
-    PlayerManager::completeAuthorizationProcess(&pl);
-    
-    // No need for reconnect since we're already authenticated
-    
-    return true;
+    PlayerManager::completeAuthorizationProcess(player);
 }
 
-bool AccountManager::changePassword(const std::string& name, const std::string& new_password) {
+bool AccountManager::changePassword(const std::string& name, const std::string& new_password, std::function<void(bool)> done) {
     std::string trimmedName = name;
     std::string trimmedNewPassword = new_password;
     trimString(trimmedName);
     trimString(trimmedNewPassword);
 
-    if (!validatePassword(trimmedNewPassword)) {
+    if (!validatePassword(trimmedNewPassword) || !hashPool_ || !ioPool_) {
         return false;
     }
 
     PlayerData data;
     data.name = trimmedName;
-    Database::loadAsAccount(data);
+    resetFlow(std::move(data), std::move(trimmedNewPassword), std::move(done));
+    return true;
+}
+
+Task AccountManager::resetFlow(PlayerData data, std::string password, std::function<void(bool)> done) {
+    // Either pool being full counts as a failed reset, nothing has been written by then
+    bool found = co_await onIoPool() && Database::loadAsAccount(data);
+    bool reset = found && co_await onHashPool();
+    if (reset) {
+        auto hashed = PasswordHasher::hash(password);
+        reset = hashed.has_value();
+        if (hashed) {
+            data.password = *hashed;
+        }
+    }
+    if (reset) {
+        reset = co_await onIoPoolForWrite();
+    }
+    if (reset) {
+        Database::storeAsAccount(data);
+    }
 
-    if (!data.valid) {
+    co_await nextTick(WorkQueue::Persistence);
+    if (reset) {
+        endSessions({data.name});
+    }
+    done(reset);
+}
+
+bool AccountManager::resumeSession(endstone::Player& pl) {
+    if (!beginRequest(pl)) {
         return false;
     }
 
-    // Hash the new password
-    data.password = SHA256::digest_str(trimmedNewPassword);
-    Database::storeAsAccount(data);
-    
+    PlayerData data;
+    data.id = PlayerManager::getId(&pl);
+    data.uuid = pl.getUniqueId();
+    data.name = pl.getName();
+    resumeFlow(pl.getUniqueId(), PlayerManager::getHandle(&pl), std::move(data));
     return true;
 }
 
+Task AccountManager::resumeFlow(endstone::UUID uuid, PlayerManager::Handle handle, PlayerData data) {
+    RequestScope request(data.id);
+
+    bool loaded = co_await onIoPool() && Database::loadAsAccount(data);
+
+    co_await nextTick();
+    auto* player = findPlayer(uuid, handle);
+    if (!player) co_return;
+
+    if (!loaded) {
+        PlayerManager::startAuthorizationProcess(player);
+        co_return;
+    }
+
+    PlayerManager::setPlayerData(player, std::move(data));
+    PlayerManager::setAuthFlags(player, AUTH_VALID | AUTH_REGISTERED | AUTH_AUTHENTICATED);
+    PlayerManager::transition(player, AuthState::Authenticated);
+    player->sendMessage(msg(MsgId::SessionResumed));
+}
+
+void AccountManager::endSessions(const std::unordered_set<std::string>& accounts) {
+    // Tickets held by players who are offline right now
+    SessionTickets::revokeAccounts(accounts);
+
+    // Collect first, kicking runs the quit pipeline and erases records
+    std::vector<endstone::Player*> affected;
+    for (const auto& data : PlayerManager::getAllData()) {
+        if (accounts.count(data.name)) {
+            auto* player = PlayerManager::getPlayerByUUID(data.uuid);
+            if (player && PlayerManager::hasAccount(player)) {
+                affected.push_back(player);
+            }
+        }
+    }
+    for (auto* player : affected) {
+        SessionTickets::revoke(player);
+        player->kick(msg(MsgId::PasswordResetKick));
+    }
+}
+
 bool AccountManager::changePassword(endstone::Player& pl, const std::string& old_password, const std::string& new_password) {
     std::string trimmedOldPassword = old_password;
     std::string trimmedNewPassword = new_password;
@@ -171,73 +430,121 @@ bool AccountManager::changePassword(endstone::Player& pl, const std::string& old
     trimString(trimmedNewPassword);
 
     if (!validatePassword(trimmedNewPassword)) {
-        pl.sendMessage(endstone::ColorFormat::Red + "New password must be at least 4 characters long!");
+        pl.sendMessage(msg(MsgId::NewPasswordTooShort));
         return false;
     }
 
     const PlayerData& currentData = PlayerManager::getPlayerData(&pl);
-    if (!currentData.valid) {
-        pl.sendMessage(endstone::ColorFormat::Red + "You are not logged in to an account!");
+    if (!PlayerManager::hasAccount(&pl)) {
+        pl.sendMessage(msg(MsgId::NotLoggedIn));
         return false;
     }
 
-    // Hash the old password and compare with stored hash
-    std::string hashedOldPassword = SHA256::digest_str(trimmedOldPassword);
-    if (currentData.password != hashedOldPassword) {
-        pl.sendMessage(endstone::ColorFormat::Red + "Incorrect old password!");
+    if (!beginRequest(pl)) {
         return false;
     }
 
-    PlayerData data = currentData;
-    // Hash the new password
-    data.password = SHA256::digest_str(trimmedNewPassword);
-    Database::storeAsAccount(data);
-    
-    pl.sendMessage(endstone::ColorFormat::Green + "Password changed successfully!");
+    changeFlow(pl.getUniqueId(), PlayerManager::getHandle(&pl), currentData.id, currentData.password,
+               std::move(trimmedOldPassword), std::move(trimmedNewPassword));
     return true;
 }
 
+Task AccountManager::changeFlow(endstone::UUID uuid, PlayerManager::Handle handle, std::string id, Credential stored,
+                                std::string oldPassword, std::string newPassword) {
+    RequestScope request(id);
+
+    // Verify the old password and hash the new one in a single hop
+    if (!co_await onHashPool()) {
+        co_await nextTick();
+        sendBusyMessage(uuid, handle);
+        co_return;
+    }
+    bool matches = PasswordHasher::verify(oldPassword, stored);
+    std::optional<Credential> hashed = matches ? PasswordHasher::hash(newPassword) : std::nullopt;
+
+    co_await nextTick();
+    auto* player = findPlayer(uuid, handle);
+    if (!player) co_return;
+
+    if (!PlayerManager::hasAccount(player)) {
+        player->sendMessage(msg(MsgId::NotLoggedIn));
+        co_return;
+    }
+
+    // The stored hash may have changed while the flow was off the main thread
+    if (!matches || PlayerManager::get(handle)->password != stored) {
+        player->sendMessage(msg(MsgId::WrongOldPassword));
+        co_return;
+    }
+    if (!hashed) {
+        player->sendMessage(msg(MsgId::HashFailed));
+        co_return;
+    }
+
+    PlayerData record;
+    PlayerManager::update(handle, [&](PlayerData& data) {
+        data.password = *hashed;
+        record = copyRecord(data);
+    });
+
+    // Only confirm once the new hash is on disk
+    if (!co_await onIoPoolForWrite()) co_return;
+    Database::storeAsAccount(record);
+
+    co_await nextTick();
+    if (auto* player = findPlayer(uuid, handle)) {
+        player->sendMessage(msg(MsgId::PasswordChanged));
+    }
+}
+
+bool AccountManager::logout(endstone::Player& pl) {
+    if (!beginRequest(pl)) {
+        return false;
+    }
+    logoutFlow(pl.getUniqueId(), PlayerManager::getHandle(&pl), PlayerManager::getId(&pl));
+    return true;
+}
+
+Task AccountManager::logoutFlow(endstone::UUID uuid, PlayerManager::Handle handle, std::string id) {
+    RequestScope request(id);
+
+    // Queued behind any store of the same record, so a pending login can't bring the file back
+    if (!co_await onIoPoolForWrite()) co_return;
+    bool removed = Database::removePlayer(id);
+
+    co_await nextTick();
+    auto* player = findPlayer(uuid, handle);
+    if (!player) co_return;
+
+    if (!removed) {
+        player->sendMessage(msg(MsgId::NotLoggedIn));
+        co_return;
+    }
+    player->sendMessage(msg(MsgId::LogoutSuccess));
+    // Logging out must not leave a resume ticket behind
+    SessionTickets::revoke(player);
+    PlayerManager::reconnect(player);
+}
+
 void AccountManager::showRegisterHelp(endstone::Player& pl) {
-    pl.sendMessage(endstone::ColorFormat::Yellow + "=== Регистрация аккаунта ===");
-    pl.sendMessage(endstone::ColorFormat::Gold + "Использование: /register <пароль> <подтверждение_пароля>");
-    pl.sendMessage(endstone::ColorFormat::Gray + "Требования:");
-    pl.sendMessage(endstone::ColorFormat::Gray + "  • Пароль: не менее 4 символов");
-    pl.sendMessage(endstone::ColorFormat::Gray + "  • Пароль и подтверждение должны совпадать");
-    pl.sendMessage(endstone::ColorFormat::Gray + "  • Аккаунт будет создан на ваш текущий никнейм");
+    Messages::send(pl, MsgId::RegisterHelp);
 }
 
 void AccountManager::showLoginHelp(endstone::Player& pl) {
-    pl.sendMessage(endstone::ColorFormat::Yellow + "=== Вход в аккаунт ===");
-    pl.sendMessage(endstone::ColorFormat::Gold + "Использование: /login <пароль>");
-    pl.sendMessage(endstone::ColorFormat::Gray + "Введите пароль для входа в ваш аккаунт.");
-    pl.sendMessage(endstone::ColorFormat::Gray + "Аккаунт привязан к вашему текущему никнейму.");
+    Messages::send(pl, MsgId::LoginHelp);
 }
 
 void AccountManager::showAccountInfo(endstone::Player& pl) {
     const PlayerData& data = PlayerManager::getPlayerData(&pl);
-    
-    pl.sendMessage(endstone::ColorFormat::Yellow + "=== Информация об аккаунте ===");
-    
-    if (data.valid && data.accounts > 0) {
-        pl.sendMessage(endstone::ColorFormat::Green + "Вы вошли как: " + data.name);
-        pl.sendMessage(endstone::ColorFormat::Gray + "Создано аккаунтов: " + std::to_string(data.accounts));
-        pl.sendMessage(endstone::ColorFormat::Gold + "Используйте /changepassword для смены пароля");
-        pl.sendMessage(endstone::ColorFormat::Gold + "Используйте /logout для выхода из аккаунта");
+    if (PlayerManager::hasAccount(&pl) && data.accounts > 0) {
+        Messages::send(pl, MsgId::AccountInfo, data.name, data.accounts);
     } else {
-        pl.sendMessage(endstone::ColorFormat::Red + "Вы не вошли в аккаунт!");
-        pl.sendMessage(endstone::ColorFormat::Gold + "Используйте /register для создания аккаунта");
-        pl.sendMessage(endstone::ColorFormat::Gold + "Используйте /login для входа в существующий аккаунт");
+        Messages::send(pl, MsgId::AccountInfoGuest);
     }
 }
 
 void AccountManager::showChangePasswordHelp(endstone::Player& pl) {
-    pl.sendMessage(endstone::ColorFormat::Yellow + "=== Смена пароля ===");
-    pl.sendMessage(endstone::ColorFormat::Gold + "Использование: /changepassword <старый_пароль> <новый_пароль> <подтверждение_нового_пароля>");
-    pl.sendMessage(endstone::ColorFormat::Gray + "Требования:");
-    pl.sendMessage(endstone::ColorFormat::Gray + "  • Вы должны быть вошли в аккаунт");
-    pl.sendMessage(endstone::ColorFormat::Gray + "  • Старый пароль должен быть верным");
-    pl.sendMessage(endstone::ColorFormat::Gray + "  • Новый пароль должен быть не менее 4 символов");
-    pl.sendMessage(endstone::ColorFormat::Gray + "  • Новый пароль и подтверждение должны совпадать");
+    Messages::send(pl, MsgId::ChangePasswordHelp);
 }
 
 } // namespace PlayerRegister
\ No newline at end of file
@@ -0,0 +1,423 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "argon2.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t BLAKE2B_IV[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+constexpr uint8_t BLAKE2B_SIGMA[12][16] = {
+    { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15},
+    {14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3},
+    {11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4},
+    { 7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8},
+    { 9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13},
+    { 2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9},
+    {12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11},
+    {13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10},
+    { 6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5},
+    {10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0},
+    { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15},
+    {14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3}
+};
+
+constexpr uint32_t SYNC_POINTS = 4;
+constexpr uint32_t ADDRESSES_IN_BLOCK = 128;
+
+inline uint64_t rotr64(uint64_t x, unsigned n) {
+    return (x >> n) | (x << (64 - n));
+}
+
+inline uint64_t load64(const uint8_t * p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+inline void store32(uint8_t * p, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+}
+
+inline void store64(uint8_t * p, uint64_t v) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+}
+
+inline void blake2bUpdate32(Blake2b & b, uint32_t v) {
+    uint8_t buf[4];
+    store32(buf, v);
+    b.update(buf, sizeof(buf));
+}
+
+// BlaMka multiplication-hardened G from the Argon2 specification
+inline uint64_t fBlaMka(uint64_t x, uint64_t y) {
+    const uint64_t m = 0xFFFFFFFFULL;
+    return x + y + 2 * ((x & m) * (y & m));
+}
+
+inline void gb(uint64_t & a, uint64_t & b, uint64_t & c, uint64_t & d) {
+    a = fBlaMka(a, b);
+    d = rotr64(d ^ a, 32);
+    c = fBlaMka(c, d);
+    b = rotr64(b ^ c, 24);
+    a = fBlaMka(a, b);
+    d = rotr64(d ^ a, 16);
+    c = fBlaMka(c, d);
+    b = rotr64(b ^ c, 63);
+}
+
+inline void roundNoMsg(uint64_t & v0, uint64_t & v1, uint64_t & v2, uint64_t & v3,
+                       uint64_t & v4, uint64_t & v5, uint64_t & v6, uint64_t & v7,
+                       uint64_t & v8, uint64_t & v9, uint64_t & v10, uint64_t & v11,
+                       uint64_t & v12, uint64_t & v13, uint64_t & v14, uint64_t & v15) {
+    gb(v0, v4, v8, v12);
+    gb(v1, v5, v9, v13);
+    gb(v2, v6, v10, v14);
+    gb(v3, v7, v11, v15);
+    gb(v0, v5, v10, v15);
+    gb(v1, v6, v11, v12);
+    gb(v2, v7, v8, v13);
+    gb(v3, v4, v9, v14);
+}
+
+} // namespace
+
+Blake2b::Blake2b(size_t outlen) : m_buflen(0), m_outlen(std::clamp<size_t>(outlen, 1, 64)) {
+    std::memcpy(m_h, BLAKE2B_IV, sizeof(m_h));
+    m_h[0] ^= 0x01010000ULL ^ m_outlen;
+    m_t[0] = 0;
+    m_t[1] = 0;
+}
+
+void Blake2b::update(const uint8_t * data, size_t length) {
+    while (length > 0) {
+        // Keep the last block buffered, it has to be compressed with the final flag
+        if (m_buflen == sizeof(m_buf)) {
+            m_t[0] += sizeof(m_buf);
+            if (m_t[0] < sizeof(m_buf)) m_t[1]++;
+            compress(m_buf, false);
+            m_buflen = 0;
+        }
+        size_t take = std::min(length, sizeof(m_buf) - m_buflen);
+        std::memcpy(m_buf + m_buflen, data, take);
+        m_buflen += take;
+        data += take;
+        length -= take;
+    }
+}
+
+void Blake2b::final(uint8_t * out) {
+    m_t[0] += m_buflen;
+    if (m_t[0] < m_buflen) m_t[1]++;
+    std::memset(m_buf + m_buflen, 0, sizeof(m_buf) - m_buflen);
+    compress(m_buf, true);
+
+    uint8_t full[64];
+    for (int i = 0; i < 8; i++) {
+        store64(full + i * 8, m_h[i]);
+    }
+    std::memcpy(out, full, m_outlen);
+}
+
+void Blake2b::hash(uint8_t * out, size_t outlen, const uint8_t * data, size_t length) {
+    Blake2b b(outlen);
+    b.update(data, length);
+    b.final(out);
+}
+
+void Blake2b::compress(const uint8_t * block, bool last) {
+    uint64_t m[16];
+    uint64_t v[16];
+
+    for (int i = 0; i < 16; i++) {
+        m[i] = load64(block + i * 8);
+    }
+    for (int i = 0; i < 8; i++) {
+        v[i] = m_h[i];
+        v[i + 8] = BLAKE2B_IV[i];
+    }
+    v[12] ^= m_t[0];
+    v[13] ^= m_t[1];
+    if (last) {
+        v[14] = ~v[14];
+    }
+
+    auto g = [&](int r, int i, uint64_t & a, uint64_t & b, uint64_t & c, uint64_t & d) {
+        a = a + b + m[BLAKE2B_SIGMA[r][2 * i]];
+        d = rotr64(d ^ a, 32);
+        c = c + d;
+        b = rotr64(b ^ c, 24);
+        a = a + b + m[BLAKE2B_SIGMA[r][2 * i + 1]];
+        d = rotr64(d ^ a, 16);
+        c = c + d;
+        b = rotr64(b ^ c, 63);
+    };
+
+    for (int r = 0; r < 12; r++) {
+        g(r, 0, v[0], v[4], v[8], v[12]);
+        g(r, 1, v[1], v[5], v[9], v[13]);
+        g(r, 2, v[2], v[6], v[10], v[14]);
+        g(r, 3, v[3], v[7], v[11], v[15]);
+        g(r, 4, v[0], v[5], v[10], v[15]);
+        g(r, 5, v[1], v[6], v[11], v[12]);
+        g(r, 6, v[2], v[7], v[8], v[13]);
+        g(r, 7, v[3], v[4], v[9], v[14]);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        m_h[i] ^= v[i] ^ v[i + 8];
+    }
+}
+
+uint32_t Argon2id::memoryBlocks(const Params & params) {
+    uint32_t lanes = std::max<uint32_t>(params.parallelism, 1);
+    uint32_t memory = std::max(params.memoryKiB, 2 * SYNC_POINTS * lanes);
+    return memory - memory % (SYNC_POINTS * lanes);
+}
+
+void Argon2id::hashLong(uint8_t * out, size_t outlen, const uint8_t * in, size_t inlen) {
+    uint8_t lenbuf[4];
+    store32(lenbuf, static_cast<uint32_t>(outlen));
+
+    if (outlen <= 64) {
+        Blake2b b(outlen);
+        b.update(lenbuf, sizeof(lenbuf));
+        b.update(in, inlen);
+        b.final(out);
+        return;
+    }
+
+    uint8_t v[64];
+    Blake2b first(64);
+    first.update(lenbuf, sizeof(lenbuf));
+    first.update(in, inlen);
+    first.final(v);
+    std::memcpy(out, v, 32);
+    out += 32;
+    size_t remaining = outlen - 32;
+
+    while (remaining > 64) {
+        Blake2b::hash(v, 64, v, 64);
+        std::memcpy(out, v, 32);
+        out += 32;
+        remaining -= 32;
+    }
+    Blake2b::hash(v, remaining, v, 64);
+    std::memcpy(out, v, remaining);
+}
+
+void Argon2id::fillBlock(const Block & prev, const Block & ref, Block & next, bool withXor) {
+    Block r;
+    Block tmp;
+    for (int i = 0; i < 128; i++) {
+        r.v[i] = prev.v[i] ^ ref.v[i];
+        tmp.v[i] = withXor ? r.v[i] ^ next.v[i] : r.v[i];
+    }
+
+    // Apply the permutation to rows, then to columns
+    for (int i = 0; i < 8; i++) {
+        uint64_t * q = r.v + 16 * i;
+        roundNoMsg(q[0], q[1], q[2], q[3], q[4], q[5], q[6], q[7],
+                   q[8], q[9], q[10], q[11], q[12], q[13], q[14], q[15]);
+    }
+    for (int i = 0; i < 8; i++) {
+        uint64_t * q = r.v + 2 * i;
+        roundNoMsg(q[0], q[1], q[16], q[17], q[32], q[33], q[48], q[49],
+                   q[64], q[65], q[80], q[81], q[96], q[97], q[112], q[113]);
+    }
+
+    for (int i = 0; i < 128; i++) {
+        next.v[i] = tmp.v[i] ^ r.v[i];
+    }
+}
+
+void Argon2id::nextAddresses(Block & address, Block & input) {
+    static const Block zero{};
+    input.v[6]++;
+    fillBlock(zero, input, address, false);
+    fillBlock(zero, address, address, false);
+}
+
+bool Argon2id::hash(const Params & params,
+                    const uint8_t * pwd, size_t pwdlen,
+                    const uint8_t * salt, size_t saltlen,
+                    uint8_t * out, size_t outlen,
+                    const uint8_t * secret, size_t secretlen,
+                    const uint8_t * ad, size_t adlen) {
+    if (params.parallelism == 0 || params.iterations == 0 || outlen < 4 || saltlen < 8) {
+        return false;
+    }
+
+    const uint32_t lanes = params.parallelism;
+    const uint32_t blocks = memoryBlocks(params);
+    const uint32_t laneLength = blocks / lanes;
+    const uint32_t segmentLength = laneLength / SYNC_POINTS;
+
+    // H0 over all parameters and inputs
+    uint8_t h0[72];
+    Blake2b b(64);
+    blake2bUpdate32(b, lanes);
+    blake2bUpdate32(b, static_cast<uint32_t>(outlen));
+    blake2bUpdate32(b, params.memoryKiB);
+    blake2bUpdate32(b, params.iterations);
+    blake2bUpdate32(b, VERSION);
+    blake2bUpdate32(b, 2); // Argon2id
+    blake2bUpdate32(b, static_cast<uint32_t>(pwdlen));
+    b.update(pwd, pwdlen);
+    blake2bUpdate32(b, static_cast<uint32_t>(saltlen));
+    b.update(salt, saltlen);
+    blake2bUpdate32(b, static_cast<uint32_t>(secretlen));
+    if (secretlen) b.update(secret, secretlen);
+    blake2bUpdate32(b, static_cast<uint32_t>(adlen));
+    if (adlen) b.update(ad, adlen);
+    b.final(h0);
+
+    std::vector<Block> memory(blocks);
+    uint8_t blockBytes[1024];
+
+    for (uint32_t l = 0; l < lanes; l++) {
+        store32(h0 + 64, 0);
+        store32(h0 + 68, l);
+        hashLong(blockBytes, sizeof(blockBytes), h0, sizeof(h0));
+        for (int i = 0; i < 128; i++) memory[l * laneLength].v[i] = load64(blockBytes + i * 8);
+
+        store32(h0 + 64, 1);
+        hashLong(blockBytes, sizeof(blockBytes), h0, sizeof(h0));
+        for (int i = 0; i < 128; i++) memory[l * laneLength + 1].v[i] = load64(blockBytes + i * 8);
+    }
+
+    for (uint32_t pass = 0; pass < params.iterations; pass++) {
+        for (uint32_t slice = 0; slice < SYNC_POINTS; slice++) {
+            for (uint32_t lane = 0; lane < lanes; lane++) {
+                // Argon2id uses data-independent addressing for the first half of the first pass
+                const bool independent = pass == 0 && slice < SYNC_POINTS / 2;
+                Block address{};
+                Block input{};
+                if (independent) {
+                    input.v[0] = pass;
+                    input.v[1] = lane;
+                    input.v[2] = slice;
+                    input.v[3] = blocks;
+                    input.v[4] = params.iterations;
+                    input.v[5] = 2;
+                }
+
+                uint32_t start = 0;
+                if (pass == 0 && slice == 0) {
+                    start = 2;
+                    if (independent) nextAddresses(address, input);
+                }
+
+                uint32_t offset = lane * laneLength + slice * segmentLength + start;
+                uint32_t prev = offset % laneLength == 0 ? offset + laneLength - 1 : offset - 1;
+
+                for (uint32_t index = start; index < segmentLength; index++, offset++, prev++) {
+                    if (offset % laneLength == 1) {
+                        prev = offset - 1;
+                    }
+
+                    uint64_t pseudoRand;
+                    if (independent) {
+                        if (index % ADDRESSES_IN_BLOCK == 0) nextAddresses(address, input);
+                        pseudoRand = address.v[index % ADDRESSES_IN_BLOCK];
+                    } else {
+                        pseudoRand = memory[prev].v[0];
+                    }
+
+                    uint32_t refLane = static_cast<uint32_t>((pseudoRand >> 32) % lanes);
+                    if (pass == 0 && slice == 0) refLane = lane;
+                    const bool sameLane = refLane == lane;
+
+                    // Size of the reference area, as in the reference implementation's index_alpha
+                    uint32_t area;
+                    if (pass == 0) {
+                        if (slice == 0) {
+                            area = index - 1;
+                        } else if (sameLane) {
+                            area = slice * segmentLength + index - 1;
+                        } else {
+                            area = slice * segmentLength - (index == 0 ? 1 : 0);
+                        }
+                    } else if (sameLane) {
+                        area = laneLength - segmentLength + index - 1;
+                    } else {
+                        area = laneLength - segmentLength - (index == 0 ? 1 : 0);
+                    }
+
+                    uint64_t rel = pseudoRand & 0xFFFFFFFFULL;
+                    rel = (rel * rel) >> 32;
+                    rel = area - 1 - ((area * rel) >> 32);
+                    uint32_t startPos = 0;
+                    if (pass != 0) startPos = slice == SYNC_POINTS - 1 ? 0 : (slice + 1) * segmentLength;
+                    uint32_t refIndex = static_cast<uint32_t>((startPos + rel) % laneLength);
+
+                    fillBlock(memory[prev], memory[refLane * laneLength + refIndex], memory[offset], pass != 0);
+                }
+            }
+        }
+    }
+
+    // Final block is the XOR of the last column
+    Block column = memory[laneLength - 1];
+    for (uint32_t l = 1; l < lanes; l++) {
+        const Block & last = memory[l * laneLength + laneLength - 1];
+        for (int i = 0; i < 128; i++) column.v[i] ^= last.v[i];
+    }
+    for (int i = 0; i < 128; i++) store64(blockBytes + i * 8, column.v[i]);
+    hashLong(out, outlen, blockBytes, sizeof(blockBytes));
+
+    // Memory may hold password-derived state
+    std::memset(blockBytes, 0, sizeof(blockBytes));
+    for (auto & block : memory) {
+        std::memset(block.v, 0, sizeof(block.v));
+    }
+    return true;
+}
+
+bool Argon2id::selfTest() {
+    // RFC 7693 appendix A: BLAKE2b-512("abc")
+    static const uint8_t BLAKE2B_ABC[64] = {
+        0xba, 0x80, 0xa5, 0x3f, 0x98, 0x1c, 0x4d, 0x0d, 0x6a, 0x27, 0x97, 0xb6, 0x9f, 0x12, 0xf6, 0xe9,
+        0x4c, 0x21, 0x2f, 0x14, 0x68, 0x5a, 0xc4, 0xb7, 0x4b, 0x12, 0xbb, 0x6f, 0xdb, 0xff, 0xa2, 0xd1,
+        0x7d, 0x87, 0xc5, 0x39, 0x2a, 0xab, 0x79, 0x2d, 0xc2, 0x52, 0xd5, 0xde, 0x45, 0x33, 0xcc, 0x95,
+        0x18, 0xd3, 0x8a, 0xa8, 0xdb, 0xf1, 0x92, 0x5a, 0xb9, 0x23, 0x86, 0xed, 0xd4, 0x00, 0x99, 0x23
+    };
+    uint8_t digest[64];
+    Blake2b::hash(digest, sizeof(digest), reinterpret_cast<const uint8_t *>("abc"), 3);
+    if (std::memcmp(digest, BLAKE2B_ABC, sizeof(digest)) != 0) {
+        return false;
+    }
+
+    // RFC 9106 section 5.3: m=32, t=3, p=4 with secret and associated data
+    static const uint8_t ARGON2ID_TAG[32] = {
+        0x0d, 0x64, 0x0d, 0xf5, 0x8d, 0x78, 0x76, 0x6c, 0x08, 0xc0, 0x37, 0xa3, 0x4a, 0x8b, 0x53, 0xc9,
+        0xd0, 0x1e, 0xf0, 0x45, 0x2d, 0x75, 0xb6, 0x5e, 0xb5, 0x25, 0x20, 0xe9, 0x6b, 0x01, 0xe6, 0x59
+    };
+    uint8_t password[32], salt[16], secret[8], ad[12];
+    std::memset(password, 0x01, sizeof(password));
+    std::memset(salt, 0x02, sizeof(salt));
+    std::memset(secret, 0x03, sizeof(secret));
+    std::memset(ad, 0x04, sizeof(ad));
+
+    Params params;
+    params.memoryKiB = 32;
+    params.iterations = 3;
+    params.parallelism = 4;
+    uint8_t tag[32];
+    if (!hash(params, password, sizeof(password), salt, sizeof(salt), tag, sizeof(tag),
+              secret, sizeof(secret), ad, sizeof(ad))) {
+        return false;
+    }
+    return std::memcmp(tag, ARGON2ID_TAG, sizeof(tag)) == 0;
+}
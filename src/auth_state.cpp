@@ -0,0 +1,113 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "auth_state.h"
+
+#include "messages.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace PlayerRegister {
+
+std::array<std::atomic<int64_t>, AuthStateStats::STATES> AuthStateStats::population_;
+std::array<AuthStateStats::Histogram, AuthStateStats::STATES * AuthStateStats::STATES> AuthStateStats::latency_;
+std::atomic<uint64_t> AuthStateStats::rejected_{0};
+
+const char* authStateName(AuthState state) {
+    switch (state) {
+    case AuthState::Joining:
+        return "joining";
+    case AuthState::Limbo:
+        return "limbo";
+    case AuthState::Authenticating:
+        return "authenticating";
+    case AuthState::Authenticated:
+        return "authenticated";
+    case AuthState::LoggingOut:
+        return "logging_out";
+    default:
+        return "unknown";
+    }
+}
+
+AuthStateStats::Histogram& AuthStateStats::histogram(AuthState from, AuthState to) {
+    return latency_[static_cast<size_t>(from) * STATES + static_cast<size_t>(to)];
+}
+
+void AuthStateStats::enter(AuthState state) {
+    population_[static_cast<size_t>(state)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void AuthStateStats::leave(AuthState state) {
+    population_[static_cast<size_t>(state)].fetch_sub(1, std::memory_order_relaxed);
+}
+
+void AuthStateStats::record(AuthState from, AuthState to, std::chrono::steady_clock::duration elapsed) {
+    auto ms = static_cast<uint64_t>(std::max<int64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 0));
+    size_t bucket = std::min<size_t>(std::bit_width(ms), BUCKETS - 1);
+    histogram(from, to)[bucket].fetch_add(1, std::memory_order_relaxed);
+    leave(from);
+    enter(to);
+}
+
+void AuthStateStats::reject() {
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AuthStateStats::reset() {
+    for (auto& count : population_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+int64_t AuthStateStats::count(AuthState state) {
+    return population_[static_cast<size_t>(state)].load(std::memory_order_relaxed);
+}
+
+uint64_t AuthStateStats::transitions(AuthState from, AuthState to) {
+    uint64_t total = 0;
+    for (const auto& bucket : histogram(from, to)) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t AuthStateStats::quantileMs(AuthState from, AuthState to, double q) {
+    uint64_t total = transitions(from, to);
+    if (total == 0) return 0;
+
+    auto target = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+    uint64_t seen = 0;
+    const auto& buckets = histogram(from, to);
+    for (size_t i = 0; i < BUCKETS; i++) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) return uint64_t(1) << i;
+    }
+    return uint64_t(1) << (BUCKETS - 1);
+}
+
+uint64_t AuthStateStats::getRejected() {
+    return rejected_.load(std::memory_order_relaxed);
+}
+
+void AuthStateStats::describeStats(std::vector<std::string>& lines) {
+    std::string states;
+    for (size_t i = 0; i < STATES; i++) {
+        auto state = static_cast<AuthState>(i);
+        states += msg(MsgId::StatsStateItem, authStateName(state), count(state));
+    }
+    lines.push_back(msg(MsgId::StatsStates, states, getRejected()));
+
+    static const std::pair<AuthState, AuthState> TRACKED[] = {
+        {AuthState::Limbo, AuthState::Authenticating},
+        {AuthState::Authenticating, AuthState::Authenticated},
+        {AuthState::Authenticating, AuthState::Limbo},
+    };
+    for (const auto& [from, to] : TRACKED) {
+        lines.push_back(msg(MsgId::StatsTransition, authStateName(from), authStateName(to), transitions(from, to),
+                            quantileMs(from, to, 0.5), quantileMs(from, to, 0.99)));
+    }
+}
+
+} // namespace PlayerRegister
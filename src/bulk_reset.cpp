@@ -0,0 +1,275 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "bulk_reset.h"
+
+#include "account_manager.h"
+#include "database.h"
+#include "messages.h"
+#include "password_hasher.h"
+#include "random.h"
+#include "work_scheduler.h"
+
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <unordered_set>
+
+namespace PlayerRegister {
+
+endstone::Plugin* BulkReset::plugin_ = nullptr;
+std::shared_ptr<BulkReset::Job> BulkReset::current_;
+
+void BulkReset::init(endstone::Plugin& plugin) {
+    plugin_ = &plugin;
+}
+
+bool BulkReset::isRunning() {
+    return current_ != nullptr;
+}
+
+bool BulkReset::matches(const std::string& name, const std::string& pattern) {
+    // Iterative wildcard match, backtracking only to the last '*'
+    size_t n = 0, p = 0, star = std::string::npos, mark = 0;
+    auto same = [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    };
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || same(pattern[p], name[n]))) {
+            n++;
+            p++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            mark = n;
+        } else if (star != std::string::npos) {
+            p = star + 1;
+            n = ++mark;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') p++;
+    return p == pattern.size();
+}
+
+namespace {
+
+std::tm localTime(std::time_t time) {
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &time);
+#else
+    localtime_r(&time, &local);
+#endif
+    return local;
+}
+
+// Message arguments are integers or text, rates and durations go in as text
+std::string formatTenths(double value) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << value;
+    return out.str();
+}
+
+} // namespace
+
+bool BulkReset::start(endstone::CommandSender& sender, const std::vector<std::string>& filters) {
+    if (current_) {
+        Messages::send(sender, MsgId::BulkResetRunning);
+        return false;
+    }
+    if (!plugin_ || !AccountManager::getHashPool() || !AccountManager::getIoPool()) {
+        return false;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->filters = filters;
+    if (auto* player = sender.asPlayer()) {
+        job->requester = player->getName();
+    }
+    job->started = std::chrono::steady_clock::now();
+    current_ = job;
+
+    scanFlow(job);
+    return true;
+}
+
+Task BulkReset::scanFlow(std::shared_ptr<Job> job) {
+    if (!co_await onPool(AccountManager::getIoPool())) {
+        co_await nextTick(WorkQueue::Persistence);
+        abort(job, msg(MsgId::ServerBusy));
+        co_return;
+    }
+
+    for (const auto& name : Database::listAccounts()) {
+        if (std::any_of(job->filters.begin(), job->filters.end(),
+                        [&](const std::string& f) { return matches(name, f); })) {
+            job->names.push_back(name);
+        }
+    }
+
+    // The report holds plaintext secrets, keep it readable by the server user only
+    if (!job->names.empty()) {
+        std::tm local = localTime(std::time(nullptr));
+        std::ostringstream fileName;
+        fileName << "reset-" << std::put_time(&local, "%Y%m%d-%H%M%S") << ".txt";
+
+        std::error_code ec;
+        std::filesystem::path dir = std::filesystem::path(Database::getDataDir()) / "resets";
+        std::filesystem::create_directories(dir, ec);
+        job->reportPath = (dir / fileName.str()).string();
+        job->report.open(job->reportPath, std::ios::app);
+        std::filesystem::permissions(job->reportPath,
+                                     std::filesystem::perms::owner_read | std::filesystem::perms::owner_write,
+                                     std::filesystem::perm_options::replace, ec);
+    }
+    bool opened = job->report.is_open();
+
+    co_await nextTick(WorkQueue::Persistence);
+    if (job->cancelled) co_return;
+
+    if (job->names.empty()) {
+        abort(job, msg(MsgId::BulkResetNoMatches));
+        co_return;
+    }
+    if (!opened) {
+        abort(job, msg(MsgId::BulkResetReportFailed, job->reportPath));
+        co_return;
+    }
+
+    notify(*job, msg(MsgId::BulkResetFound, job->names.size()));
+    pump(job);
+}
+
+void BulkReset::cancel() {
+    if (!current_) return;
+    // A batch may be on the I/O thread right now, the report closes with the last reference
+    current_->cancelled = true;
+    current_->pending.clear();
+    current_.reset();
+}
+
+void BulkReset::pump(const std::shared_ptr<Job>& job) {
+    if (job->cancelled || job->finished) return;
+
+    WorkerPool* pool = AccountManager::getHashPool();
+    if (!pool) return;
+
+    // Keep only as many jobs queued as there are workers so logins are not starved
+    const size_t window = std::max<size_t>(pool->getStats().threads, 1);
+    while (job->inFlight < window && job->next < job->names.size()) {
+        std::string name = job->names[job->next];
+        bool queued = pool->submit(
+            [name]() {
+                Result result;
+                result.name = name;
+                result.password = Random::digits(AccountManager::RESET_PASSWORD_DIGITS);
+                result.credential = PasswordHasher::hash(result.password);
+                return result;
+            },
+            [job](Result result) {
+                job->inFlight--;
+                if (job->cancelled) return;
+                job->pending.push_back(std::move(result));
+                if (job->pending.size() >= BATCH_SIZE) {
+                    commit(job);
+                }
+                pump(job);
+            },
+            WorkQueue::Persistence);
+
+        if (!queued) {
+            // Queue is full of player requests, try again next tick
+            if (job->inFlight == 0) {
+                WorkScheduler::post(WorkQueue::Housekeeping, [job]() { pump(job); });
+            }
+            return;
+        }
+        job->inFlight++;
+        job->next++;
+    }
+
+    if (job->next == job->names.size() && job->inFlight == 0) {
+        commit(job);
+        if (job->committing == 0) {
+            finish(job);
+        }
+    }
+}
+
+void BulkReset::commit(const std::shared_ptr<Job>& job) {
+    if (job->pending.empty()) return;
+
+    std::vector<Result> batch;
+    batch.swap(job->pending);
+    job->committing++;
+    commitFlow(job, std::move(batch));
+}
+
+Task BulkReset::commitFlow(std::shared_ptr<Job> job, std::vector<Result> batch) {
+    // Writes are never turned away; this only fails once the plugin shuts down
+    if (!co_await onPoolUnbounded(AccountManager::getIoPool())) co_return;
+    if (job->cancelled) co_return;
+
+    std::unordered_set<std::string> changed;
+    size_t failed = 0;
+    for (auto& result : batch) {
+        PlayerData data;
+        data.name = result.name;
+        if (!result.credential || !Database::loadAsAccount(data)) {
+            failed++;
+            continue;
+        }
+        data.password = *result.credential;
+        Database::storeAsAccount(data);
+        job->report << result.name << ' ' << result.password << '\n';
+        changed.insert(result.name);
+    }
+    job->report.flush();
+
+    co_await nextTick(WorkQueue::Persistence);
+    job->committing--;
+    job->committed += changed.size();
+    job->failed += failed;
+
+    // Sessions on reset accounts are no longer trusted
+    AccountManager::endSessions(changed);
+    if (job->cancelled) co_return;
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - job->started).count();
+    notify(*job, msg(MsgId::BulkResetProgress, job->committed + job->failed, job->names.size(),
+                     formatTenths(elapsed > 0 ? job->committed / elapsed : 0.0)));
+    pump(job);
+}
+
+void BulkReset::finish(const std::shared_ptr<Job>& job) {
+    job->finished = true;
+    if (current_ == job) {
+        current_.reset();
+    }
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - job->started).count();
+    notify(*job, msg(MsgId::BulkResetFinished, job->committed, job->failed, formatTenths(elapsed), job->reportPath));
+}
+
+void BulkReset::abort(const std::shared_ptr<Job>& job, const std::string& message) {
+    job->finished = true;
+    if (current_ == job) {
+        current_.reset();
+    }
+    notify(*job, message);
+}
+
+void BulkReset::notify(const Job& job, const std::string& message) {
+    if (!plugin_) return;
+    plugin_->getLogger().info(message);
+    if (!job.requester.empty()) {
+        if (auto* player = plugin_->getServer().getPlayer(job.requester)) {
+            player->sendMessage(endstone::ColorFormat::Gray + message);
+        }
+    }
+}
+
+} // namespace PlayerRegister
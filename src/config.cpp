@@ -2,6 +2,9 @@
 
 #include "config.h"
 
+#include "pepper.h"
+
+#include <filesystem>
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include <sstream>
@@ -21,11 +24,16 @@ bool Config::init(const std::string& configDir) {
 #endif
     std::system(dirCmd.c_str());
     
-    if (!loadConfig(configPath)) {
-        return saveConfig(configPath);
+    if (!loadConfig(configPath) && !saveConfig(configPath)) {
+        return false;
     }
-    
-    return true;
+
+    // The pepper is loaded once here; hashing only ever sees its cached midstates
+    std::filesystem::path pepperPath(instance.pepper_file);
+    if (pepperPath.is_relative()) {
+        pepperPath = std::filesystem::path(configDir) / pepperPath;
+    }
+    return Pepper::load(pepperPath.string(), instance.pepper_grace_days);
 }
 
 bool Config::loadConfig(const std::string& configPath) {
@@ -46,6 +54,24 @@ bool Config::loadConfig(const std::string& configPath) {
         if (j.contains("reconnect_port")) instance.reconnect_port = j["reconnect_port"].get<unsigned short>();
         if (j.contains("fake_uuid")) instance.fake_uuid = j["fake_uuid"].get<bool>();
         if (j.contains("fake_xuid")) instance.fake_xuid = j["fake_xuid"].get<bool>();
+        if (j.contains("hash_threads")) instance.hash_threads = j["hash_threads"].get<int>();
+        if (j.contains("hash_queue_capacity")) instance.hash_queue_capacity = j["hash_queue_capacity"].get<int>();
+        if (j.contains("io_queue_capacity")) instance.io_queue_capacity = j["io_queue_capacity"].get<int>();
+        if (j.contains("hash_algorithm")) instance.hash_algorithm = j["hash_algorithm"].get<std::string>();
+        if (j.contains("argon2_memory_kib")) instance.argon2_memory_kib = j["argon2_memory_kib"].get<int>();
+        if (j.contains("argon2_iterations")) instance.argon2_iterations = j["argon2_iterations"].get<int>();
+        if (j.contains("argon2_parallelism")) instance.argon2_parallelism = j["argon2_parallelism"].get<int>();
+        if (j.contains("argon2_memory_budget_mib")) instance.argon2_memory_budget_mib = j["argon2_memory_budget_mib"].get<int>();
+        if (j.contains("session_resume_seconds")) instance.session_resume_seconds = j["session_resume_seconds"].get<int>();
+        if (j.contains("session_ticket_capacity")) instance.session_ticket_capacity = j["session_ticket_capacity"].get<int>();
+        if (j.contains("login_attempts_burst")) instance.login_attempts_burst = j["login_attempts_burst"].get<int>();
+        if (j.contains("login_attempts_per_minute")) instance.login_attempts_per_minute = j["login_attempts_per_minute"].get<int>();
+        if (j.contains("pepper_file")) instance.pepper_file = j["pepper_file"].get<std::string>();
+        if (j.contains("pepper_grace_days")) instance.pepper_grace_days = j["pepper_grace_days"].get<int>();
+        if (j.contains("admission_budget_us")) instance.admission_budget_us = j["admission_budget_us"].get<int>();
+        if (j.contains("admission_max_waiting")) instance.admission_max_waiting = j["admission_max_waiting"].get<int>();
+        if (j.contains("tick_budget_us")) instance.tick_budget_us = j["tick_budget_us"].get<int>();
+        if (j.contains("log_level")) instance.log_level = j["log_level"].get<std::string>();
         
     } catch (const nlohmann::json::exception& e) {
         return false;
@@ -65,6 +91,24 @@ bool Config::saveConfig(const std::string& configPath) {
     j["reconnect_port"] = instance.reconnect_port;
     j["fake_uuid"] = instance.fake_uuid;
     j["fake_xuid"] = instance.fake_xuid;
+    j["hash_threads"] = instance.hash_threads;
+    j["hash_queue_capacity"] = instance.hash_queue_capacity;
+    j["io_queue_capacity"] = instance.io_queue_capacity;
+    j["hash_algorithm"] = instance.hash_algorithm;
+    j["argon2_memory_kib"] = instance.argon2_memory_kib;
+    j["argon2_iterations"] = instance.argon2_iterations;
+    j["argon2_parallelism"] = instance.argon2_parallelism;
+    j["argon2_memory_budget_mib"] = instance.argon2_memory_budget_mib;
+    j["session_resume_seconds"] = instance.session_resume_seconds;
+    j["session_ticket_capacity"] = instance.session_ticket_capacity;
+    j["login_attempts_burst"] = instance.login_attempts_burst;
+    j["login_attempts_per_minute"] = instance.login_attempts_per_minute;
+    j["pepper_file"] = instance.pepper_file;
+    j["pepper_grace_days"] = instance.pepper_grace_days;
+    j["admission_budget_us"] = instance.admission_budget_us;
+    j["admission_max_waiting"] = instance.admission_max_waiting;
+    j["tick_budget_us"] = instance.tick_budget_us;
+    j["log_level"] = instance.log_level;
     
     std::ofstream file(configPath);
     if (!file.is_open()) {
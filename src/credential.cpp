@@ -0,0 +1,182 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "credential.h"
+
+#include "argon2.h"
+#include "hex.h"
+
+#include <charconv>
+
+namespace PlayerRegister {
+
+namespace {
+
+constexpr char BASE64_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+constexpr std::array<uint8_t, 256> BASE64_VALUES = []() {
+    std::array<uint8_t, 256> table{};
+    for (auto& v : table) v = 0xFF;
+    for (int i = 0; i < 64; i++) table[static_cast<uint8_t>(BASE64_CHARS[i])] = static_cast<uint8_t>(i);
+    return table;
+}();
+
+// Unpadded base64 as used by PHC strings
+void encodeBase64(const uint8_t* data, size_t length, std::string& out) {
+    uint32_t acc = 0;
+    int bits = 0;
+    for (size_t i = 0; i < length; i++) {
+        acc = (acc << 8) | data[i];
+        bits += 8;
+        while (bits >= 6) {
+            bits -= 6;
+            out.push_back(BASE64_CHARS[(acc >> bits) & 0x3F]);
+        }
+    }
+    if (bits > 0) {
+        out.push_back(BASE64_CHARS[(acc << (6 - bits)) & 0x3F]);
+    }
+}
+
+// Returns the number of decoded bytes, or -1 if the input is malformed or too long
+int decodeBase64(std::string_view in, uint8_t* out, size_t capacity) {
+    uint32_t acc = 0;
+    int bits = 0;
+    size_t length = 0;
+    for (char c : in) {
+        uint8_t value = BASE64_VALUES[static_cast<uint8_t>(c)];
+        if (value == 0xFF) return -1;
+        acc = (acc << 6) | value;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            if (length == capacity) return -1;
+            out[length++] = static_cast<uint8_t>((acc >> bits) & 0xFF);
+        }
+    }
+    return static_cast<int>(length);
+}
+
+bool nextField(std::string_view& text, std::string_view& field) {
+    if (text.empty() || text[0] != '$') return false;
+    text.remove_prefix(1);
+    size_t end = text.find('$');
+    field = text.substr(0, end);
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end);
+    return true;
+}
+
+bool parseUint(std::string_view text, uint32_t& value) {
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+} // namespace
+
+std::string Credential::toString() const {
+    if (algorithm == HashAlgorithm::SHA256) {
+        if (pepperId == 0) {
+            return hex::encode(digest.data(), digest.size());
+        }
+        return "$sha256$k=" + std::to_string(pepperId) + "$" + hex::encode(digest.data(), digest.size());
+    }
+    if (algorithm != HashAlgorithm::Argon2id) {
+        return "";
+    }
+
+    std::string out;
+    out.reserve(96);
+    out += "$argon2id$v=";
+    out += std::to_string(Argon2id::VERSION);
+    out += "$m=";
+    out += std::to_string(memoryKiB);
+    out += ",t=";
+    out += std::to_string(iterations);
+    out += ",p=";
+    out += std::to_string(parallelism);
+    if (pepperId != 0) {
+        out += ",k=";
+        out += std::to_string(pepperId);
+    }
+    out += '$';
+    encodeBase64(salt.data(), saltLength, out);
+    out += '$';
+    encodeBase64(digest.data(), digest.size(), out);
+    return out;
+}
+
+std::optional<Credential> Credential::parse(std::string_view text, const CredentialLimits& limits) {
+    Credential credential;
+
+    if (text.size() == 64) {
+        if (!hex::decode(text, credential.digest.data(), credential.digest.size())) {
+            return std::nullopt;
+        }
+        credential.algorithm = HashAlgorithm::SHA256;
+        return credential;
+    }
+
+    std::string_view id, version, params, salt, hash;
+    uint32_t pepperId = 0;
+
+    // $sha256$k=..$hex
+    if (text.substr(0, 8) == "$sha256$") {
+        if (!nextField(text, id) || !nextField(text, params) || !nextField(text, hash) || !text.empty() ||
+            params.substr(0, 2) != "k=" || !parseUint(params.substr(2), pepperId) || pepperId == 0 || pepperId > 255 ||
+            !hex::decode(hash, credential.digest.data(), credential.digest.size())) {
+            return std::nullopt;
+        }
+        credential.algorithm = HashAlgorithm::SHA256;
+        credential.pepperId = static_cast<uint8_t>(pepperId);
+        return credential;
+    }
+
+    // $argon2id$v=19$m=..,t=..,p=..[,k=..]$salt$hash
+    if (!nextField(text, id) || id != "argon2id" || !nextField(text, version) ||
+        version != "v=19" || !nextField(text, params) ||
+        !nextField(text, salt) || !nextField(text, hash) || !text.empty()) {
+        return std::nullopt;
+    }
+
+    while (!params.empty()) {
+        size_t end = params.find(',');
+        std::string_view param = params.substr(0, end);
+        params.remove_prefix(end == std::string_view::npos ? params.size() : end + 1);
+
+        if (param.size() < 3 || param[1] != '=') return std::nullopt;
+        uint32_t* target = nullptr;
+        switch (param[0]) {
+        case 'm': target = &credential.memoryKiB; break;
+        case 't': target = &credential.iterations; break;
+        case 'p': target = &credential.parallelism; break;
+        case 'k': target = &pepperId; break;
+        default: return std::nullopt;
+        }
+        if (!parseUint(param.substr(2), *target)) return std::nullopt;
+    }
+
+    int saltLength = decodeBase64(salt, credential.salt.data(), credential.salt.size());
+    int hashLength = decodeBase64(hash, credential.digest.data(), credential.digest.size());
+    if (saltLength < 8 || hashLength != static_cast<int>(credential.digest.size()) ||
+        credential.memoryKiB == 0 || credential.iterations == 0 || credential.parallelism == 0 || pepperId > 255) {
+        return std::nullopt;
+    }
+    if (credential.memoryKiB > limits.maxMemoryKiB || credential.iterations > limits.maxIterations ||
+        credential.parallelism > limits.maxParallelism) {
+        return std::nullopt;
+    }
+
+    credential.algorithm = HashAlgorithm::Argon2id;
+    credential.saltLength = static_cast<uint8_t>(saltLength);
+    credential.pepperId = static_cast<uint8_t>(pepperId);
+    return credential;
+}
+
+bool constantTimeEqual(const std::array<uint8_t, 32>& a, const std::array<uint8_t, 32>& b) {
+    volatile uint8_t diff = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        diff = diff | (a[i] ^ b[i]);
+    }
+    return diff == 0;
+}
+
+} // namespace PlayerRegister
@@ -2,9 +2,12 @@
 
 #include "database.h"
 
+#include "password_hasher.h"
+
 #include <fstream>
 #include <endstone/logger.h>
 #include <algorithm>
+#include <filesystem>
 #include <sstream>
 
 namespace PlayerRegister {
@@ -24,6 +27,10 @@ bool Database::init(const std::string& dataDir) {
     return true;
 }
 
+const std::string& Database::getDataDir() {
+    return dataDir_;
+}
+
 std::string Database::getPlayerFilePath(const std::string& id) {
     return dataDir_ + "/players/" + id + ".json";
 }
@@ -40,7 +47,7 @@ void Database::ensureDirectoryExists(const std::string& path) {
 nlohmann::json Database::serializeData(const PlayerData& data) {
     nlohmann::json j;
     j["name"] = data.name;
-    j["password"] = data.password;
+    j["password"] = data.password.toString();
     j["accounts"] = data.accounts;
     j["fakeUUID"] = data.fakeUUID.str();
     j["fakeXUID"] = data.fakeXUID;
@@ -50,11 +57,10 @@ nlohmann::json Database::serializeData(const PlayerData& data) {
 
 void Database::deserializeData(const nlohmann::json& j, PlayerData& data) {
     data.name = j["name"].get<std::string>();
-    data.password = j["password"].get<std::string>();
+    data.password = Credential::parse(j["password"].get<std::string>(), PasswordHasher::getCredentialLimits()).value_or(Credential{});
     data.accounts = j["accounts"].get<int>();
     // Parse UUID from string using shared function
-    std::string uuidStr = j["fakeUUID"].get<std::string>();
-    data.fakeUUID = PlayerManager::parseUUIDFromString(uuidStr);
+    data.fakeUUID = PlayerManager::parseUUID(j["fakeUUID"].get_ref<const std::string&>()).value_or(endstone::UUID{});
     data.fakeXUID = j["fakeXUID"].get<std::string>();
     data.fakeDBkey = j["fakeDBkey"].get<std::string>();
 }
@@ -70,20 +76,22 @@ void Database::storeAsPlayer(const PlayerData& data) {
     }
 }
 
-void Database::loadAsPlayer(PlayerData& data) {
+bool Database::loadAsPlayer(PlayerData& data) {
     std::string filePath = getPlayerFilePath(data.id);
     std::ifstream file(filePath);
     
-    if (file.is_open()) {
-        try {
-            nlohmann::json j;
-            file >> j;
-            deserializeData(j, data);
-            data.valid = true;
-        } catch (const nlohmann::json::exception& e) {
-            // Invalid JSON, keep data.valid = false
-        }
-        file.close();
+    if (!file.is_open()) {
+        return false;
+    }
+
+    try {
+        nlohmann::json j;
+        file >> j;
+        deserializeData(j, data);
+        return true;
+    } catch (const nlohmann::json::exception& e) {
+        // Invalid JSON counts as no record
+        return false;
     }
 }
 
@@ -104,21 +112,35 @@ void Database::storeAsAccount(const PlayerData& data) {
     }
 }
 
-void Database::loadAsAccount(PlayerData& data) {
+bool Database::loadAsAccount(PlayerData& data) {
     std::string filePath = getAccountFilePath(data.name);
     std::ifstream file(filePath);
     
-    if (file.is_open()) {
-        try {
-            nlohmann::json j;
-            file >> j;
-            deserializeData(j, data);
-            data.valid = true;
-        } catch (const nlohmann::json::exception& e) {
-            // Invalid JSON, keep data.valid = false
+    if (!file.is_open()) {
+        return false;
+    }
+
+    try {
+        nlohmann::json j;
+        file >> j;
+        deserializeData(j, data);
+        return true;
+    } catch (const nlohmann::json::exception& e) {
+        // Invalid JSON counts as no record
+        return false;
+    }
+}
+
+std::vector<std::string> Database::listAccounts() {
+    std::vector<std::string> names;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dataDir_ + "/accounts", ec)) {
+        if (entry.is_regular_file(ec) && entry.path().extension() == ".json") {
+            names.push_back(entry.path().stem().string());
         }
-        file.close();
     }
+    std::sort(names.begin(), names.end());
+    return names;
 }
 
 } // namespace PlayerRegister
\ No newline at end of file
@@ -0,0 +1,46 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "hmac.h"
+
+#include <cstring>
+
+KeyedHasher::KeyedHasher() : KeyedHasher(nullptr, 0) {}
+
+KeyedHasher::KeyedHasher(const uint8_t * key, size_t keylen)
+    : m_inner(SHA256::Variant::Standard), m_outer(SHA256::Variant::Standard) {
+    uint8_t block[64] = {};
+    if (keylen > sizeof(block)) {
+        SHA256 keyHash(SHA256::Variant::Standard);
+        keyHash.update(key, keylen);
+        auto digest = keyHash.digest();
+        std::memcpy(block, digest.data(), digest.size());
+    } else if (keylen > 0) {
+        std::memcpy(block, key, keylen);
+    }
+
+    uint8_t pad[64];
+    for (int i = 0; i < 64; i++) pad[i] = block[i] ^ 0x36;
+    m_inner.update(pad, sizeof(pad));
+    for (int i = 0; i < 64; i++) pad[i] = block[i] ^ 0x5c;
+    m_outer.update(pad, sizeof(pad));
+
+    // Only the midstates are kept
+    volatile uint8_t * wipe = block;
+    for (size_t i = 0; i < sizeof(block); i++) wipe[i] = 0;
+    wipe = pad;
+    for (size_t i = 0; i < sizeof(pad); i++) wipe[i] = 0;
+}
+
+std::array<uint8_t, 32> KeyedHasher::mac(const uint8_t * data, size_t length) const {
+    SHA256 inner = m_inner;
+    inner.update(data, length);
+    auto innerDigest = inner.digest();
+
+    SHA256 outer = m_outer;
+    outer.update(innerDigest.data(), innerDigest.size());
+    return outer.digest();
+}
+
+std::array<uint8_t, 32> hmacSha256(const uint8_t * key, size_t keylen, const uint8_t * data, size_t length) {
+    return KeyedHasher(key, keylen).mac(data, length);
+}
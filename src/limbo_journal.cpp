@@ -0,0 +1,286 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "limbo_journal.h"
+
+#include "log.h"
+#include "messages.h"
+#include "player_manager.h"
+
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+
+namespace PlayerRegister {
+
+std::string LimboJournal::path_;
+std::unordered_map<std::string, LimboRecord> LimboJournal::open_;
+uint64_t LimboJournal::recovered_ = 0;
+std::mutex LimboJournal::mutex_;
+std::condition_variable LimboJournal::cv_;
+std::vector<LimboJournal::Op> LimboJournal::queue_;
+bool LimboJournal::running_ = false;
+std::thread LimboJournal::thread_;
+std::FILE* LimboJournal::file_ = nullptr;
+std::unordered_map<std::string, std::string> LimboJournal::live_;
+uint64_t LimboJournal::linesInFile_ = 0;
+std::atomic<uint64_t> LimboJournal::appended_{0};
+std::atomic<uint64_t> LimboJournal::batches_{0};
+std::atomic<uint64_t> LimboJournal::compactions_{0};
+
+namespace {
+
+std::string serializeEnter(const LimboRecord& record) {
+    nlohmann::json j;
+    j["op"] = "enter";
+    j["id"] = record.id;
+    if (record.hasLocation) {
+        j["dim"] = record.dimension;
+        j["pos"] = {record.x, record.y, record.z, record.yaw, record.pitch};
+    }
+    auto& items = j["items"] = nlohmann::json::array();
+    for (const auto& item : record.items) {
+        items.push_back({item.slot, item.type, item.amount, item.data, item.lossy ? 1 : 0});
+    }
+    return j.dump();
+}
+
+std::string serializeRestore(const std::string& id) {
+    nlohmann::json j;
+    j["op"] = "restore";
+    j["id"] = id;
+    return j.dump();
+}
+
+void deserializeEnter(const nlohmann::json& j, LimboRecord& record) {
+    record.id = j.at("id").get<std::string>();
+    if (j.contains("pos")) {
+        const auto& pos = j.at("pos");
+        record.hasLocation = true;
+        record.dimension = j.value("dim", std::string());
+        record.x = pos.at(0).get<float>();
+        record.y = pos.at(1).get<float>();
+        record.z = pos.at(2).get<float>();
+        record.yaw = pos.at(3).get<float>();
+        record.pitch = pos.at(4).get<float>();
+    }
+    for (const auto& item : j.at("items")) {
+        // Lines written before the lossy flag have four fields
+        record.items.push_back({item.at(0).get<uint16_t>(), item.at(1).get<std::string>(), item.at(2).get<int>(),
+                                item.at(3).get<int>(), item.size() > 4 && item.at(4).get<int>() != 0});
+    }
+}
+
+} // namespace
+
+bool LimboJournal::open(const std::string& dataDir) {
+    close();
+    path_ = dataDir + "/limbo.journal";
+
+    // Replay: an enter opens an entry, a restore closes it. A crash can leave
+    // a torn last line, which is skipped.
+    size_t skipped = 0;
+    std::ifstream in(path_);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        try {
+            auto j = nlohmann::json::parse(line);
+            const std::string& op = j.at("op").get_ref<const std::string&>();
+            if (op == "enter") {
+                LimboRecord record;
+                deserializeEnter(j, record);
+                live_[record.id] = line;
+                open_[record.id] = std::move(record);
+            } else if (op == "restore") {
+                std::string id = j.at("id").get<std::string>();
+                live_.erase(id);
+                open_.erase(id);
+            }
+        } catch (const nlohmann::json::exception&) {
+            skipped++;
+        }
+    }
+    in.close();
+
+    if (skipped > 0) {
+        LOG_WARNING("limbo.journal_skipped", {"lines", skipped});
+    }
+    if (!open_.empty()) {
+        LOG_INFO("limbo.journal_replayed", {"open", open_.size()});
+    }
+
+    // Start from a file holding only the open entries
+    if (!compact()) {
+        return false;
+    }
+    running_ = true;
+    thread_ = std::thread(writerLoop);
+    return true;
+}
+
+void LimboJournal::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+    queue_.clear();
+    open_.clear();
+    live_.clear();
+}
+
+void LimboJournal::recordEnter(const std::string& id, const LimboState& limbo) {
+    LimboRecord record;
+    record.id = id;
+    if (limbo.originalLocation) {
+        const auto& location = *limbo.originalLocation;
+        record.hasLocation = true;
+        if (auto* dimension = location.getDimension()) {
+            record.dimension = dimension->getName();
+        }
+        record.x = location.getX();
+        record.y = location.getY();
+        record.z = location.getZ();
+        record.yaw = limbo.originalYaw;
+        record.pitch = limbo.originalPitch;
+    }
+    const auto& inventory = limbo.savedInventory;
+    record.items.reserve(inventory.size());
+    for (size_t i = 0; i < inventory.size(); i++) {
+        const auto& item = inventory.itemAt(i);
+        record.items.push_back(
+            {inventory.slotAt(i), item.getType(), item.getAmount(), item.getData(), item.hasItemMeta()});
+    }
+
+    open_[id] = record;
+    push(Op{true, std::move(record)});
+}
+
+void LimboJournal::recordRestore(const std::string& id) {
+    if (open_.erase(id) == 0) return;
+    LimboRecord record;
+    record.id = id;
+    push(Op{false, std::move(record)});
+}
+
+std::optional<LimboRecord> LimboJournal::take(const std::string& id) {
+    auto it = open_.find(id);
+    if (it == open_.end()) return std::nullopt;
+
+    LimboRecord record = std::move(it->second);
+    recordRestore(id);
+    recovered_++;
+    return record;
+}
+
+LimboJournal::Stats LimboJournal::getStats() {
+    Stats stats;
+    stats.pending = open_.size();
+    stats.appended = appended_.load(std::memory_order_relaxed);
+    stats.batches = batches_.load(std::memory_order_relaxed);
+    stats.compactions = compactions_.load(std::memory_order_relaxed);
+    stats.recovered = recovered_;
+    return stats;
+}
+
+void LimboJournal::describeStats(std::vector<std::string>& lines) {
+    auto stats = getStats();
+    lines.push_back(msg(MsgId::StatsJournal, stats.pending, stats.appended, stats.batches, stats.compactions,
+                        stats.recovered));
+}
+
+void LimboJournal::push(Op op) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        queue_.push_back(std::move(op));
+    }
+    cv_.notify_one();
+}
+
+void LimboJournal::writerLoop() {
+    std::vector<Op> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, []() { return !running_ || !queue_.empty(); });
+        if (queue_.empty()) break; // stopping and nothing left
+
+        // Let a join storm pile up into one write
+        if (running_) {
+            cv_.wait_for(lock, BATCH_WINDOW, []() { return !running_; });
+        }
+        batch.swap(queue_);
+        lock.unlock();
+        writeBatch(batch);
+        batch.clear();
+        lock.lock();
+    }
+}
+
+void LimboJournal::writeBatch(std::vector<Op>& batch) {
+    std::string out;
+    for (auto& op : batch) {
+        const std::string& id = op.record.id;
+        if (op.enter) {
+            std::string& line = live_[id];
+            line = serializeEnter(op.record);
+            out += line;
+        } else {
+            live_.erase(id);
+            out += serializeRestore(id);
+        }
+        out += '\n';
+    }
+
+    if (file_) {
+        std::fwrite(out.data(), 1, out.size(), file_);
+        std::fflush(file_);
+    }
+    linesInFile_ += batch.size();
+    appended_.fetch_add(batch.size(), std::memory_order_relaxed);
+    batches_.fetch_add(1, std::memory_order_relaxed);
+
+    if (linesInFile_ > live_.size() * 2 + COMPACT_SLACK) {
+        compact();
+    }
+}
+
+bool LimboJournal::compact() {
+    // Write the open entries next to the journal and swap it in
+    std::string tmpPath = path_ + ".tmp";
+    std::FILE* tmp = std::fopen(tmpPath.c_str(), "wb");
+    if (!tmp) {
+        LOG_ERROR("limbo.journal_compact_failed", {"path", tmpPath});
+        return file_ != nullptr;
+    }
+    for (const auto& [id, line] : live_) {
+        std::fwrite(line.data(), 1, line.size(), tmp);
+        std::fputc('\n', tmp);
+    }
+    std::fclose(tmp);
+
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path_, ec);
+    if (ec) {
+        LOG_ERROR("limbo.journal_compact_failed", {"path", path_}, {"error", ec.message()});
+    } else {
+        linesInFile_ = live_.size();
+        compactions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    file_ = std::fopen(path_.c_str(), "ab");
+    return file_ != nullptr;
+}
+
+} // namespace PlayerRegister
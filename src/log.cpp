@@ -0,0 +1,203 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "log.h"
+
+#include "messages.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+
+namespace PlayerRegister {
+
+std::atomic<uint8_t> Log::level_{static_cast<uint8_t>(LogLevel::Off)};
+std::array<Log::Slot, Log::CAPACITY> Log::ring_;
+std::atomic<size_t> Log::head_{0};
+size_t Log::tail_ = 0;
+std::atomic<uint64_t> Log::written_{0};
+std::atomic<uint64_t> Log::dropped_{0};
+std::atomic<bool> Log::running_{false};
+std::thread Log::thread_;
+endstone::Logger* Log::logger_ = nullptr;
+
+namespace {
+
+// Appends into a fixed buffer, silently truncating at the end
+class SlotWriter {
+public:
+    SlotWriter(char* data, size_t capacity) : data_(data), capacity_(capacity) {}
+
+    void put(std::string_view text)
+    {
+        size_t n = std::min(text.size(), capacity_ - length_);
+        std::copy_n(text.data(), n, data_ + length_);
+        length_ += n;
+    }
+
+    void put(char c)
+    {
+        if (length_ < capacity_) data_[length_++] = c;
+    }
+
+    template <typename T>
+    void number(T value)
+    {
+        auto result = std::to_chars(data_ + length_, data_ + capacity_, value);
+        if (result.ec == std::errc()) length_ = static_cast<size_t>(result.ptr - data_);
+    }
+
+    void real(double value)
+    {
+        char buffer[32];
+        int n = std::snprintf(buffer, sizeof(buffer), "%.2f", value);
+        if (n > 0) put(std::string_view(buffer, std::min<size_t>(n, sizeof(buffer) - 1)));
+    }
+
+    size_t length() const { return length_; }
+
+private:
+    char* data_;
+    size_t capacity_;
+    size_t length_ = 0;
+};
+
+} // namespace
+
+void Log::start(endstone::Plugin& plugin, LogLevel level) {
+    stop();
+    logger_ = &plugin.getLogger();
+    for (size_t i = 0; i < CAPACITY; i++) {
+        ring_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    head_.store(0, std::memory_order_relaxed);
+    tail_ = 0;
+    running_ = true;
+    thread_ = std::thread(drain);
+    level_.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+void Log::stop() {
+    level_.store(static_cast<uint8_t>(LogLevel::Off), std::memory_order_relaxed);
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool Log::parseLevel(std::string_view name, LogLevel& level) {
+    static constexpr std::pair<std::string_view, LogLevel> NAMES[] = {
+        {"debug", LogLevel::Debug}, {"info", LogLevel::Info}, {"warning", LogLevel::Warning},
+        {"error", LogLevel::Error}, {"off", LogLevel::Off},
+    };
+    for (const auto& [n, l] : NAMES) {
+        if (n == name) {
+            level = l;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Log::write(LogLevel level, std::string_view event, std::initializer_list<LogField> fields) {
+    // Claim a slot (bounded MPMC queue with per-slot sequence numbers)
+    size_t pos = head_.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &ring_[pos & (CAPACITY - 1)];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+
+    SlotWriter out(slot->text, RECORD_SIZE);
+    out.put(event);
+    for (const auto& field : fields) {
+        out.put(' ');
+        out.put(field.key_);
+        out.put('=');
+        switch (field.type_) {
+        case LogField::Type::String:
+            if (field.string_.find(' ') == std::string_view::npos) {
+                out.put(field.string_);
+            } else {
+                out.put('"');
+                out.put(field.string_);
+                out.put('"');
+            }
+            break;
+        case LogField::Type::Signed:
+            out.number(field.signed_);
+            break;
+        case LogField::Type::Unsigned:
+            out.number(field.unsigned_);
+            break;
+        case LogField::Type::Real:
+            out.real(field.real_);
+            break;
+        }
+    }
+    slot->level = level;
+    slot->length = static_cast<uint16_t>(out.length());
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    written_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool Log::pop(std::string& out, LogLevel& level) {
+    Slot& slot = ring_[tail_ & (CAPACITY - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != tail_ + 1) {
+        return false;
+    }
+    out.assign(slot.text, slot.length);
+    level = slot.level;
+    slot.sequence.store(tail_ + CAPACITY, std::memory_order_release);
+    tail_++;
+    return true;
+}
+
+void Log::drain() {
+    std::string text;
+    LogLevel level;
+    while (true) {
+        bool stopping = !running_.load();
+        bool any = false;
+        while (pop(text, level)) {
+            any = true;
+            switch (level) {
+            case LogLevel::Error:
+                logger_->error("{}", text);
+                break;
+            case LogLevel::Warning:
+                logger_->warning("{}", text);
+                break;
+            default:
+                logger_->info("{}", text);
+                break;
+            }
+        }
+        // Records still being written when stop() was called are lost
+        if (stopping) break;
+        if (!any) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+uint64_t Log::getWritten() {
+    return written_.load(std::memory_order_relaxed);
+}
+
+uint64_t Log::getDropped() {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+void Log::describeStats(std::vector<std::string>& lines) {
+    lines.push_back(msg(MsgId::StatsLog, getWritten(), getDropped()));
+}
+
+} // namespace PlayerRegister
@@ -0,0 +1,316 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "messages.h"
+
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace PlayerRegister {
+
+std::array<Messages::Entry, static_cast<size_t>(MsgId::Count)> Messages::entries_;
+
+namespace {
+
+struct Default {
+    MsgId id;
+    const char* key;
+    std::string text;
+};
+
+// Built-in texts, also exported to lang/ru_RU.json as a template for translations
+std::vector<Default> defaults() {
+    using endstone::ColorFormat;
+    return {
+        {MsgId::RequestPending, "request_pending", ColorFormat::Red + "Предыдущий запрос ещё обрабатывается, подождите."},
+        {MsgId::ServerBusy, "server_busy", ColorFormat::Red + "Сервер перегружен, попробуйте ещё раз через несколько секунд."},
+        {MsgId::HashFailed, "hash_failed", ColorFormat::Red + "Не удалось обработать пароль, попробуйте ещё раз позже."},
+        {MsgId::PasswordTooShort, "password_too_short", ColorFormat::Red + "Пароль должен быть не менее 4 символов!"},
+        {MsgId::NewPasswordTooShort, "new_password_too_short", ColorFormat::Red + "Новый пароль должен быть не менее 4 символов!"},
+        {MsgId::PasswordsMismatch, "passwords_mismatch", ColorFormat::Red + "Пароли не совпадают!"},
+        {MsgId::NewPasswordsMismatch, "new_passwords_mismatch", ColorFormat::Red + "Новые пароли не совпадают!"},
+        {MsgId::AccountExists, "account_exists", ColorFormat::Red + "Аккаунт с таким никнеймом ({0}) уже существует."},
+        {MsgId::MaxAccounts, "max_accounts", ColorFormat::Red + "Вы уже создали максимальное количество аккаунтов ({0})!"},
+        {MsgId::AccountCreated, "account_created", ColorFormat::Green + "Аккаунт успешно создан!"},
+        {MsgId::AccountNotFound, "account_not_found", ColorFormat::Red + "Аккаунт не найден!"},
+        {MsgId::WrongPassword, "wrong_password", ColorFormat::Red + "Неверный пароль!"},
+        {MsgId::WrongOldPassword, "wrong_old_password", ColorFormat::Red + "Неверный старый пароль!"},
+        {MsgId::LoginSuccess, "login_success", ColorFormat::Green + "Успешный вход в систему!"},
+        {MsgId::PasswordChanged, "password_changed", ColorFormat::Green + "Пароль успешно изменён!"},
+        {MsgId::NotLoggedIn, "not_logged_in", ColorFormat::Red + "Вы не вошли в аккаунт!"},
+        {MsgId::TooManyLoginAttempts, "too_many_login_attempts",
+         ColorFormat::Red + "Слишком много попыток входа. Подождите немного и попробуйте снова."},
+        {MsgId::LogoutSuccess, "logout_success", ColorFormat::Green + "Успешный выход из аккаунта!"},
+        {MsgId::RegisterHelp, "register_help",
+         ColorFormat::Yellow + "=== Регистрация аккаунта ===\n" +
+         ColorFormat::Gold + "Использование: /register <пароль> <подтверждение_пароля>\n" +
+         ColorFormat::Gray + "Требования:\n" +
+         ColorFormat::Gray + "  • Пароль: не менее 4 символов\n" +
+         ColorFormat::Gray + "  • Пароль и подтверждение должны совпадать\n" +
+         ColorFormat::Gray + "  • Аккаунт будет создан на ваш текущий никнейм"},
+        {MsgId::LoginHelp, "login_help",
+         ColorFormat::Yellow + "=== Вход в аккаунт ===\n" +
+         ColorFormat::Gold + "Использование: /login <пароль>\n" +
+         ColorFormat::Gray + "Введите пароль для входа в ваш аккаунт.\n" +
+         ColorFormat::Gray + "Аккаунт привязан к вашему текущему никнейму."},
+        {MsgId::ChangePasswordHelp, "change_password_help",
+         ColorFormat::Yellow + "=== Смена пароля ===\n" +
+         ColorFormat::Gold + "Использование: /changepassword <старый_пароль> <новый_пароль> <подтверждение_нового_пароля>\n" +
+         ColorFormat::Gray + "Требования:\n" +
+         ColorFormat::Gray + "  • Вы должны быть вошли в аккаунт\n" +
+         ColorFormat::Gray + "  • Старый пароль должен быть верным\n" +
+         ColorFormat::Gray + "  • Новый пароль должен быть не менее 4 символов\n" +
+         ColorFormat::Gray + "  • Новый пароль и подтверждение должны совпадать"},
+        {MsgId::AccountInfo, "account_info",
+         ColorFormat::Yellow + "=== Информация об аккаунте ===\n" +
+         ColorFormat::Green + "Вы вошли как: {0}\n" +
+         ColorFormat::Gray + "Создано аккаунтов: {1}\n" +
+         ColorFormat::Gold + "Используйте /changepassword для смены пароля\n" +
+         ColorFormat::Gold + "Используйте /logout для выхода из аккаунта"},
+        {MsgId::AccountInfoGuest, "account_info_guest",
+         ColorFormat::Yellow + "=== Информация об аккаунте ===\n" +
+         ColorFormat::Red + "Вы не вошли в аккаунт!\n" +
+         ColorFormat::Gold + "Используйте /register для создания аккаунта\n" +
+         ColorFormat::Gold + "Используйте /login для входа в существующий аккаунт"},
+        {MsgId::AccountCommands, "account_commands",
+         ColorFormat::Yellow + "Команды управления аккаунтом:\n" +
+         ColorFormat::Gold + "/account - Показать информацию об аккаунте\n" +
+         ColorFormat::Gold + "/register <пароль> <подтверждение> - Создать аккаунт\n" +
+         ColorFormat::Gold + "/login <пароль> - Войти в аккаунт\n" +
+         ColorFormat::Gold + "/changepassword <старый> <новый> <подтверждение> - Сменить пароль\n" +
+         ColorFormat::Gold + "/logout - Выйти из аккаунта"},
+        {MsgId::ChatBlocked, "chat_blocked",
+         ColorFormat::Red + "Вы должны авторизоваться, чтобы писать в чат!\n" +
+         ColorFormat::Gold + "Используйте /register <пароль> <подтверждение> или /login <пароль>"},
+        {MsgId::CommandBlocked, "command_blocked",
+         ColorFormat::Red + "Вы должны авторизоваться, чтобы использовать команды!\n" +
+         ColorFormat::Gold + "Используйте /register <пароль> <подтверждение> или /login <пароль>"},
+        {MsgId::Welcome, "welcome",
+         ColorFormat::Yellow + "Добро пожаловать на сервер!\n" +
+         ColorFormat::Gold + "Пожалуйста, зарегистрируйтесь или войдите в аккаунт чтобы играть.\n" +
+         ColorFormat::Gold + "Используйте /register <пароль> <подтверждение> для регистрации\n" +
+         ColorFormat::Gold + "Или /login <пароль> для входа в существующий аккаунт"},
+        {MsgId::AuthQueued, "auth_queued",
+         ColorFormat::Yellow + "Сервер сейчас принимает много игроков, вы в очереди на вход.\n" +
+         ColorFormat::Gold + "Время на авторизацию начнёт идти, как только подойдёт ваша очередь."},
+        {MsgId::Frozen, "frozen",
+         ColorFormat::Red + "Вы заморожены! Пожалуйста, зарегистрируйтесь чтобы играть.\n" +
+         ColorFormat::Gold + "Используйте /register <пароль> <подтверждение> для регистрации\n" +
+         ColorFormat::Gold + "Или /login <пароль> для входа в существующий аккаунт"},
+        {MsgId::Unfrozen, "unfrozen", ColorFormat::Green + "Вы успешно разморожены! Добро пожаловать на сервер!"},
+        {MsgId::RegistrationKick, "registration_kick",
+         ColorFormat::Red + "Вы были кикнуты за то, что не зарегистрировались в течение 2 минут 20 секунд!"},
+        {MsgId::RegistrationTimeLeft, "registration_time_left",
+         ColorFormat::Yellow + "Пожалуйста, зарегистрируйтесь! У вас осталось {0} минут {1} секунд.\n" +
+         ColorFormat::Gold + "/register <пароль> <подтверждение> или /login <пароль>"},
+        {MsgId::AuthTitle, "auth_title", "Пожалуйста, зарегистрируйтесь"},
+        {MsgId::AuthSubtitle, "auth_subtitle", "для продолжения игры"},
+        {MsgId::AuthTimeout, "auth_timeout", ColorFormat::Red + "Время авторизации истекло"},
+        {MsgId::AuthTimeLeft, "auth_time_left", ColorFormat::Yellow + "[Auth] У вас осталось {0} секунд для авторизации!"},
+        {MsgId::AuthHints, "auth_hints",
+         ColorFormat::Gold + "Используйте /register <пароль> <подтверждение> для регистрации\n" +
+         ColorFormat::Gold + "Или /login <пароль> для входа в существующий аккаунт"},
+        {MsgId::AuthTitleUrgent, "auth_title_urgent", "СРОЧНО АВТОРИЗУЙТЕСЬ!"},
+        {MsgId::AuthTitleNormal, "auth_title_normal", "Требуется авторизация"},
+        {MsgId::AuthSubtitleTimeLeft, "auth_subtitle_time_left", "Осталось: {0} секунд"},
+        {MsgId::AuthSuccess, "auth_success", ColorFormat::Green + "Вы успешно авторизованы! Добро пожаловать на сервер!"},
+        {MsgId::SessionResumed, "session_resumed", ColorFormat::Green + "Сессия восстановлена, повторный вход не требуется."},
+        {MsgId::Reconnect, "reconnect", ColorFormat::Yellow + "Переподключитесь к серверу, чтобы завершить вход."},
+        {MsgId::PasswordResetKick, "password_reset_kick", ColorFormat::Red + "Пароль вашего аккаунта был сброшен администратором."},
+
+        // Operator commands. Texts that are also written to the server log carry no colors.
+        {MsgId::ResetPasswordUsage, "reset_password_usage", ColorFormat::Red + "Использование: /resetpassword <ник>"},
+        {MsgId::ResetPasswordDone, "reset_password_done", "Пароль для аккаунта '{0}' был сброшен на: {1}"},
+        {MsgId::ResetPasswordFailed, "reset_password_failed", "Аккаунт '{0}' не найден или сервер перегружен!"},
+        {MsgId::ResetPasswordsUsage, "reset_passwords_usage",
+         ColorFormat::Red + "Использование: /resetpasswords <ник|шаблон> [ник|шаблон...]\n" +
+         ColorFormat::Red + "Шаблоны поддерживают * и ?, например: /resetpasswords bot_* Steve"},
+        {MsgId::BulkResetRunning, "bulk_reset_running", ColorFormat::Red + "Массовый сброс уже выполняется!"},
+        {MsgId::BulkResetNoMatches, "bulk_reset_no_matches", "Не найдено ни одного подходящего аккаунта."},
+        {MsgId::BulkResetReportFailed, "bulk_reset_report_failed", "Не удалось создать файл отчёта: {0}"},
+        {MsgId::BulkResetFound, "bulk_reset_found", "Массовый сброс паролей: найдено аккаунтов: {0}"},
+        {MsgId::BulkResetProgress, "bulk_reset_progress", "Массовый сброс: {0}/{1} ({2} акк/с)"},
+        {MsgId::BulkResetFinished, "bulk_reset_finished",
+         "Массовый сброс завершён: сброшено {0}, ошибок {1} за {2} с. Новые пароли: {3}"},
+        {MsgId::PepperRotationPending, "pepper_rotation_pending",
+         ColorFormat::Red + "Предыдущий ключ ещё действует. Дождитесь окончания переходного периода."},
+        {MsgId::PepperSaveFailed, "pepper_save_failed", ColorFormat::Red + "Не удалось сохранить новый ключ!"},
+        {MsgId::PepperRotated, "pepper_rotated", ColorFormat::Green + "Новый ключ перца: {0}. Старый ключ действует ещё {1} дн."},
+        {MsgId::StatsHeader, "stats_header", ColorFormat::Yellow + "=== Статистика хеширования ==="},
+        {MsgId::StatsHashThreads, "stats_hash_threads", ColorFormat::Gray + "Потоков: {0}, очередь: {1}/{2}"},
+        {MsgId::StatsHashCounts, "stats_hash_counts", ColorFormat::Gray + "Принято: {0}, отклонено: {1}, выполнено: {2}"},
+        {MsgId::StatsHashLatency, "stats_hash_latency",
+         ColorFormat::Gray + "Ожидание: {0} мкс, хеширование: {1} мкс, максимум: {2} мкс"},
+        {MsgId::StatsIoPool, "stats_io_pool",
+         ColorFormat::Gray + "Файловый поток: очередь {0}/{1}, выполнено {2}, отклонено {3}, задержка до {4} мкс"},
+        {MsgId::StatsArgon2Memory, "stats_argon2_memory", ColorFormat::Gray + "Память Argon2: {0}/{1} МиБ"},
+        {MsgId::StatsPlayers, "stats_players", ColorFormat::Gray + "Игроков онлайн: {0}, в лимбо: {1}, таймеров: {2}"},
+        {MsgId::StatsSnapshot, "stats_snapshot", ColorFormat::Gray + "Снимок состояния: версия {0}, ждут освобождения {1}"},
+        {MsgId::StatsStates, "stats_states", ColorFormat::Gray + "Состояния:{0}, отклонено переходов: {1}"},
+        {MsgId::StatsStateItem, "stats_state_item", " {0} {1}"},
+        {MsgId::StatsTransition, "stats_transition", ColorFormat::Gray + "  {0} -> {1}: {2}, p50 <{3} мс, p99 <{4} мс"},
+        {MsgId::StatsSchedulerTick, "stats_scheduler_tick",
+         ColorFormat::Gray + "Тик планировщика: {0} мкс (макс. {1} мкс), перенесено тиков: {2}"},
+        {MsgId::StatsQueue, "stats_queue",
+         ColorFormat::Gray + "  {0}: ждёт {1}, выполнено {2}, задержка {3} мкс (макс. {4} мкс)"},
+        {MsgId::QueueAuth, "queue_auth", "авторизация"},
+        {MsgId::QueuePersistence, "queue_persistence", "сохранение"},
+        {MsgId::QueueReminders, "queue_reminders", "напоминания"},
+        {MsgId::QueueHousekeeping, "queue_housekeeping", "обслуживание"},
+        {MsgId::StatsAdmission, "stats_admission",
+         ColorFormat::Gray + "Очередь входа: {0} (макс. {1}), обработано: {2}, удержано тиков: {3}, тик: {4} мкс (макс. {5} мкс)"},
+        {MsgId::StatsJoinStages, "stats_join_stages", ColorFormat::Gray + "Вход (сред./макс.):{0}"},
+        {MsgId::StatsQuitStages, "stats_quit_stages", ColorFormat::Gray + "Выход (сред./макс.):{0}"},
+        {MsgId::StatsStageItem, "stats_stage_item", " {0} {1}/{2} мкс"},
+        {MsgId::StatsJournal, "stats_journal",
+         ColorFormat::Gray + "Журнал лимбо: открыто {0}, записей {1} в {2} пакетах, сжатий {3}, восстановлено {4}"},
+        {MsgId::StatsPepper, "stats_pepper", ColorFormat::Gray + "Ключ перца: {0}, предыдущий: {1}"},
+        {MsgId::StatsTickets, "stats_tickets", ColorFormat::Gray + "Активных тикетов сессий: {0}"},
+        {MsgId::StatsRateLimiter, "stats_rate_limiter",
+         ColorFormat::Gray + "Отклонено попыток входа: {0}, переполнений таблицы: {1}"},
+        {MsgId::StatsLog, "stats_log", ColorFormat::Gray + "Записей лога: {0}, потеряно: {1}"},
+    };
+}
+
+const char* KEYS[static_cast<size_t>(MsgId::Count)] = {};
+
+} // namespace
+
+const char* Messages::key(MsgId id) {
+    const char* k = KEYS[index(id)];
+    return k ? k : "";
+}
+
+void Messages::compile(Entry& entry, const std::string& text) {
+    entry.lines.clear();
+    entry.whole = text;
+
+    size_t start = 0;
+    while (true) {
+        size_t end = text.find('\n', start);
+        Line line;
+        line.text = text.substr(start, end == std::string::npos ? std::string::npos : end - start);
+
+        // Split into literal runs and {N} placeholders
+        const std::string& raw = line.text;
+        size_t literal = 0;
+        for (size_t i = 0; i + 2 < raw.size(); i++) {
+            if (raw[i] != '{' || raw[i + 2] != '}' || raw[i + 1] < '0' || raw[i + 1] > '9') continue;
+            if (i > literal) {
+                line.segments.push_back({static_cast<uint32_t>(literal), static_cast<uint32_t>(i - literal), -1});
+            }
+            line.segments.push_back({0, 0, raw[i + 1] - '0'});
+            line.hasArgs = true;
+            literal = i + 3;
+            i += 2;
+        }
+        if (literal < raw.size()) {
+            line.segments.push_back({static_cast<uint32_t>(literal), static_cast<uint32_t>(raw.size() - literal), -1});
+        }
+        entry.lines.push_back(std::move(line));
+
+        if (end == std::string::npos) break;
+        start = end + 1;
+    }
+}
+
+void Messages::appendLine(std::string& out, const Line& line, const MsgArg* args, size_t count) {
+    for (const auto& segment : line.segments) {
+        if (segment.arg < 0) {
+            out.append(line.text, segment.offset, segment.length);
+        } else if (static_cast<size_t>(segment.arg) < count) {
+            out.append(args[segment.arg].view());
+        }
+    }
+}
+
+const std::string& Messages::formatArgs(MsgId id, const MsgArg* args, size_t count) {
+    thread_local std::string buffer;
+    buffer.clear();
+    const Entry& entry = entries_[index(id)];
+    for (size_t i = 0; i < entry.lines.size(); i++) {
+        if (i > 0) buffer += '\n';
+        appendLine(buffer, entry.lines[i], args, count);
+    }
+    return buffer;
+}
+
+void Messages::sendArgs(const endstone::CommandSender& to, MsgId id, const MsgArg* args, size_t count) {
+    thread_local std::string buffer;
+    for (const auto& line : entries_[index(id)].lines) {
+        if (!line.hasArgs) {
+            to.sendMessage(line.text);
+            continue;
+        }
+        buffer.clear();
+        appendLine(buffer, line, args, count);
+        to.sendMessage(buffer);
+    }
+}
+
+bool Messages::exportDefaults(const std::string& path) {
+    nlohmann::ordered_json j;
+    for (const auto& d : defaults()) {
+        // Multi-line blocks are written as arrays so they stay readable
+        if (d.text.find('\n') == std::string::npos) {
+            j[d.key] = d.text;
+            continue;
+        }
+        nlohmann::json lines = nlohmann::json::array();
+        for (const auto& line : entries_[index(d.id)].lines) {
+            lines.push_back(line.text);
+        }
+        j[d.key] = lines;
+    }
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << j.dump(4);
+    return true;
+}
+
+bool Messages::load(const std::string& langDir, const std::string& lang) {
+    for (auto& d : defaults()) {
+        KEYS[index(d.id)] = d.key;
+        compile(entries_[index(d.id)], d.text);
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(langDir, ec);
+    std::string templatePath = langDir + "/ru_RU.json";
+    if (!std::filesystem::exists(templatePath, ec)) {
+        exportDefaults(templatePath);
+    }
+
+    // Missing keys keep their built-in text
+    std::ifstream file(langDir + "/" + lang + ".json");
+    if (!file.is_open()) {
+        return true;
+    }
+
+    try {
+        nlohmann::json j;
+        file >> j;
+        for (size_t i = 0; i < entries_.size(); i++) {
+            if (!KEYS[i] || !j.contains(KEYS[i])) continue;
+            const auto& value = j[KEYS[i]];
+            std::string text;
+            if (value.is_array()) {
+                for (size_t n = 0; n < value.size(); n++) {
+                    if (n > 0) text += '\n';
+                    text += value[n].get<std::string>();
+                }
+            } else {
+                text = value.get<std::string>();
+            }
+            compile(entries_[i], text);
+        }
+    } catch (const nlohmann::json::exception& e) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace PlayerRegister
@@ -0,0 +1,192 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "password_hasher.h"
+
+#include "config.h"
+#include "log.h"
+#include "messages.h"
+#include "pepper.h"
+#include "random.h"
+#include "sha256.h"
+
+#include <algorithm>
+
+namespace PlayerRegister {
+
+HashAlgorithm PasswordHasher::algorithm_ = HashAlgorithm::SHA256;
+bool PasswordHasher::argon2Verified_ = false;
+Argon2id::Params PasswordHasher::argon2Params_;
+std::mutex PasswordHasher::budgetMutex_;
+std::condition_variable PasswordHasher::budgetCv_;
+uint64_t PasswordHasher::budgetInUseKiB_ = 0;
+uint64_t PasswordHasher::budgetLimitKiB_ = 256 * 1024;
+
+namespace {
+
+constexpr size_t SALT_LENGTH = 16;
+
+} // namespace
+
+void PasswordHasher::init() {
+    const auto& config = Config::getInstance();
+    algorithm_ = config.hash_algorithm == "argon2id" ? HashAlgorithm::Argon2id : HashAlgorithm::SHA256;
+
+    // SHA256 is checked at compile time. A miscompiled Argon2id would lock
+    // every account it hashes, so it stays off unless it reproduces the RFC vectors.
+    argon2Verified_ = Argon2id::selfTest();
+    if (!argon2Verified_) {
+        LOG_ERROR("hasher.self_test_failed", {"algorithm", "argon2id"});
+        algorithm_ = HashAlgorithm::SHA256;
+    }
+    const CredentialLimits limits;
+    const uint64_t budgetKiB = static_cast<uint64_t>(std::max(config.argon2_memory_budget_mib, 1)) * 1024;
+
+    // Our own hashes have to stay within what parse() and the budget accept
+    uint64_t memoryKiB = std::clamp<uint64_t>(std::max(config.argon2_memory_kib, 8), 8, limits.maxMemoryKiB);
+    argon2Params_.memoryKiB = static_cast<uint32_t>(std::min(memoryKiB, budgetKiB));
+    argon2Params_.iterations = std::clamp<uint32_t>(std::max(config.argon2_iterations, 1), 1, limits.maxIterations);
+    argon2Params_.parallelism = std::clamp<uint32_t>(std::max(config.argon2_parallelism, 1), 1, limits.maxParallelism);
+
+    std::lock_guard<std::mutex> lock(budgetMutex_);
+    budgetLimitKiB_ = budgetKiB;
+}
+
+bool PasswordHasher::prepare(const std::string& password, uint8_t pepperId, std::string& out) {
+    if (pepperId == 0) {
+        out = password;
+        return true;
+    }
+    std::array<uint8_t, 32> mac;
+    if (!Pepper::apply(pepperId, password, mac)) {
+        return false;
+    }
+    out.assign(reinterpret_cast<const char*>(mac.data()), mac.size());
+    return true;
+}
+
+std::optional<Credential> PasswordHasher::hash(const std::string& password) {
+    uint8_t pepperId = Pepper::currentId();
+    std::string prepared;
+    if (!prepare(password, pepperId, prepared)) {
+        return std::nullopt;
+    }
+
+    std::optional<Credential> credential;
+    if (algorithm_ == HashAlgorithm::Argon2id) {
+        credential = hashArgon2(prepared);
+    } else {
+        credential.emplace();
+        credential->algorithm = HashAlgorithm::SHA256;
+        credential->digest = SHA256::hash(prepared);
+    }
+    if (credential) {
+        credential->pepperId = pepperId;
+    }
+    return credential;
+}
+
+bool PasswordHasher::verify(const std::string& password, const Credential& stored) {
+    std::string prepared;
+    if (!prepare(password, stored.pepperId, prepared)) {
+        return false;
+    }
+    switch (stored.algorithm) {
+    case HashAlgorithm::SHA256: return constantTimeEqual(SHA256::hash(prepared), stored.digest);
+    case HashAlgorithm::Argon2id: return verifyArgon2(prepared, stored);
+    default: return false;
+    }
+}
+
+bool PasswordHasher::needsRehash(const Credential& stored) {
+    if (stored.algorithm != algorithm_ || stored.pepperId != Pepper::currentId()) {
+        return true;
+    }
+    return algorithm_ == HashAlgorithm::Argon2id &&
+           (stored.memoryKiB != argon2Params_.memoryKiB || stored.iterations != argon2Params_.iterations ||
+            stored.parallelism != argon2Params_.parallelism);
+}
+
+HashAlgorithm PasswordHasher::getAlgorithm() {
+    return algorithm_;
+}
+
+uint64_t PasswordHasher::getMemoryInUseKiB() {
+    std::lock_guard<std::mutex> lock(budgetMutex_);
+    return budgetInUseKiB_;
+}
+
+uint64_t PasswordHasher::getMemoryBudgetKiB() {
+    std::lock_guard<std::mutex> lock(budgetMutex_);
+    return budgetLimitKiB_;
+}
+
+void PasswordHasher::describeStats(std::vector<std::string>& lines) {
+    lines.push_back(msg(MsgId::StatsArgon2Memory, getMemoryInUseKiB() / 1024, getMemoryBudgetKiB() / 1024));
+}
+
+CredentialLimits PasswordHasher::getCredentialLimits() {
+    CredentialLimits limits;
+    limits.maxMemoryKiB = static_cast<uint32_t>(std::min<uint64_t>(limits.maxMemoryKiB, getMemoryBudgetKiB()));
+    return limits;
+}
+
+std::optional<Credential> PasswordHasher::hashArgon2(const std::string& password) {
+    Credential credential;
+    credential.algorithm = HashAlgorithm::Argon2id;
+    credential.saltLength = SALT_LENGTH;
+    credential.memoryKiB = argon2Params_.memoryKiB;
+    credential.iterations = argon2Params_.iterations;
+    credential.parallelism = argon2Params_.parallelism;
+
+    Random::fill(credential.salt.data(), SALT_LENGTH);
+
+    MemoryReservation memory(Argon2id::memoryBlocks(argon2Params_));
+    if (!memory) {
+        return std::nullopt;
+    }
+    if (!Argon2id::hash(argon2Params_, reinterpret_cast<const uint8_t*>(password.data()), password.size(),
+                        credential.salt.data(), credential.saltLength, credential.digest.data(),
+                        credential.digest.size())) {
+        return std::nullopt;
+    }
+    return credential;
+}
+
+bool PasswordHasher::verifyArgon2(const std::string& password, const Credential& stored) {
+    if (!argon2Verified_) {
+        return false;
+    }
+    Argon2id::Params params;
+    params.memoryKiB = stored.memoryKiB;
+    params.iterations = stored.iterations;
+    params.parallelism = stored.parallelism;
+
+    MemoryReservation memory(Argon2id::memoryBlocks(params));
+    if (!memory) {
+        return false;
+    }
+    std::array<uint8_t, 32> actual;
+    bool ok = Argon2id::hash(params, reinterpret_cast<const uint8_t*>(password.data()), password.size(),
+                             stored.salt.data(), stored.saltLength, actual.data(), actual.size());
+    return ok && constantTimeEqual(actual, stored.digest);
+}
+
+bool PasswordHasher::acquireMemory(uint64_t kib) {
+    std::unique_lock<std::mutex> lock(budgetMutex_);
+    if (kib == 0 || kib > budgetLimitKiB_) {
+        return false;
+    }
+    budgetCv_.wait(lock, [kib]() { return budgetInUseKiB_ + kib <= budgetLimitKiB_; });
+    budgetInUseKiB_ += kib;
+    return true;
+}
+
+void PasswordHasher::releaseMemory(uint64_t kib) {
+    {
+        std::lock_guard<std::mutex> lock(budgetMutex_);
+        budgetInUseKiB_ -= kib;
+    }
+    budgetCv_.notify_all();
+}
+
+} // namespace PlayerRegister
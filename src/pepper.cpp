@@ -0,0 +1,169 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "pepper.h"
+
+#include "hex.h"
+#include "messages.h"
+#include "random.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace PlayerRegister {
+
+std::mutex Pepper::mutex_;
+Pepper::Ring Pepper::ring_;
+std::string Pepper::path_;
+int Pepper::graceDays_ = 30;
+
+namespace {
+
+bool readKey(const nlohmann::json& j, uint8_t& id, std::array<uint8_t, 32>& secret) {
+    if (!j.is_object() || !j.contains("id") || !j.contains("key")) return false;
+    int value = j["id"].get<int>();
+    if (value < 1 || value > 255) return false;
+    id = static_cast<uint8_t>(value);
+    return hex::decode(j["key"].get<std::string>(), secret.data(), secret.size());
+}
+
+} // namespace
+
+std::shared_ptr<const Pepper::Key> Pepper::makeKey(uint8_t id, const std::array<uint8_t, 32>& secret, std::time_t expires) {
+    auto key = std::make_shared<Key>();
+    key->id = id;
+    key->secret = secret;
+    key->hasher = KeyedHasher(secret.data(), secret.size());
+    key->expires = expires;
+    return key;
+}
+
+bool Pepper::load(const std::string& path, int graceDays) {
+    path_ = path;
+    graceDays_ = std::max(graceDays, 0);
+
+    Ring ring;
+    std::ifstream file(path);
+    if (file.is_open()) {
+        try {
+            nlohmann::json j;
+            file >> j;
+            uint8_t id;
+            std::array<uint8_t, 32> secret;
+            if (!j.contains("current") || !readKey(j["current"], id, secret)) {
+                return false;
+            }
+            ring.current = makeKey(id, secret, 0);
+            if (j.contains("previous") && readKey(j["previous"], id, secret)) {
+                std::time_t expires = j["previous"].value("expires", static_cast<std::time_t>(0));
+                if (expires > std::time(nullptr)) {
+                    ring.previous = makeKey(id, secret, expires);
+                }
+            }
+        } catch (const nlohmann::json::exception& e) {
+            // Never replace a key file we could not read, accounts depend on it
+            return false;
+        }
+    } else {
+        std::array<uint8_t, 32> secret;
+        Random::fill(secret.data(), secret.size());
+        ring.current = makeKey(1, secret, 0);
+        if (!save(ring)) {
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_ = ring;
+    return true;
+}
+
+bool Pepper::save(const Ring& ring) {
+    nlohmann::json j;
+    j["current"] = {{"id", ring.current->id}, {"key", hex::encode(ring.current->secret.data(), ring.current->secret.size())}};
+    if (ring.previous) {
+        j["previous"] = {{"id", ring.previous->id},
+                         {"key", hex::encode(ring.previous->secret.data(), ring.previous->secret.size())},
+                         {"expires", ring.previous->expires}};
+    }
+
+    // Write a sibling file and rename it so a crash never leaves a torn key file
+    std::string temp = path_ + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file << j.dump(4);
+        if (!file.good()) {
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::permissions(temp, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write,
+                                 std::filesystem::perm_options::replace, ec);
+    std::filesystem::rename(temp, path_, ec);
+    return !ec;
+}
+
+Pepper::Ring Pepper::snapshot() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ring_;
+}
+
+bool Pepper::rotate() {
+    Ring ring = snapshot();
+    if (!ring.current) return false;
+
+    uint8_t id = static_cast<uint8_t>(ring.current->id == 255 ? 1 : ring.current->id + 1);
+    std::array<uint8_t, 32> secret;
+    Random::fill(secret.data(), secret.size());
+
+    Ring next;
+    next.current = makeKey(id, secret, 0);
+    next.previous = makeKey(ring.current->id, ring.current->secret,
+                            std::time(nullptr) + static_cast<std::time_t>(graceDays_) * 86400);
+    if (!save(next)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_ = next;
+    return true;
+}
+
+uint8_t Pepper::currentId() {
+    Ring ring = snapshot();
+    return ring.current ? ring.current->id : 0;
+}
+
+uint8_t Pepper::previousId() {
+    Ring ring = snapshot();
+    return ring.previous && ring.previous->expires > std::time(nullptr) ? ring.previous->id : 0;
+}
+
+std::time_t Pepper::previousExpires() {
+    Ring ring = snapshot();
+    return ring.previous ? ring.previous->expires : 0;
+}
+
+void Pepper::describeStats(std::vector<std::string>& lines) {
+    lines.push_back(msg(MsgId::StatsPepper, currentId(), previousId()));
+}
+
+bool Pepper::apply(uint8_t id, const std::string& password, std::array<uint8_t, 32>& out) {
+    Ring ring = snapshot();
+    const Key* key = nullptr;
+    if (ring.current && ring.current->id == id) {
+        key = ring.current.get();
+    } else if (ring.previous && ring.previous->id == id && ring.previous->expires > std::time(nullptr)) {
+        key = ring.previous.get();
+    }
+    if (!key) return false;
+
+    out = key->hasher.mac(reinterpret_cast<const uint8_t*>(password.data()), password.size());
+    return true;
+}
+
+} // namespace PlayerRegister
@@ -2,58 +2,328 @@
 
 #include "player_manager.h"
 
+#include "account_manager.h"
+#include "config.h"
+#include "database.h"
+#include "hex.h"
+#include "limbo_journal.h"
+#include "log.h"
+#include "messages.h"
+#include "session_tickets.h"
+#include "work_scheduler.h"
+
 #include <endstone/endstone.hpp>
 #include <thread>
-#include <sstream>
 #include <algorithm>
+#include <cstring>
 
 namespace PlayerRegister {
 
-std::unordered_map<endstone::Player*, PlayerData> PlayerManager::playerDataMap;
+SlotMap<PlayerData> PlayerManager::players_;
+UuidIndex PlayerManager::index_;
+std::vector<uint8_t> PlayerManager::flags_;
+std::vector<std::unique_ptr<LimboState>> PlayerManager::limbo_;
+std::vector<std::unique_ptr<LimboState>> PlayerManager::limboPool_;
+std::vector<PlayerManager::Lifecycle> PlayerManager::lifecycle_;
+TimingWheel PlayerManager::timers_;
+std::vector<PlayerManager::ReminderBucket> PlayerManager::reminderBuckets_;
+std::deque<PlayerManager::Handle> PlayerManager::admission_;
+PlayerManager::AdmissionStats PlayerManager::admissionStats_;
+size_t PlayerManager::preparedCount_ = 0;
+const PlayerManager::Stage PlayerManager::joinStages_[JOIN_STAGES] = {
+    {"recover", &PlayerManager::joinRecover},
+    {"resume", &PlayerManager::joinResume},
+    {"record", &PlayerManager::joinRecord},
+    {"gate", &PlayerManager::joinGate},
+};
+const PlayerManager::Stage PlayerManager::quitStages_[QUIT_STAGES] = {
+    {"leave", &PlayerManager::quitLeave},
+    {"ticket", &PlayerManager::quitTicket},
+    {"timers", &PlayerManager::quitTimers},
+    {"limbo", &PlayerManager::quitLimbo},
+    {"record", &PlayerManager::quitRecord},
+};
+std::array<PlayerManager::StageTimes, PlayerManager::JOIN_STAGES> PlayerManager::joinTimes_;
+std::array<PlayerManager::StageTimes, PlayerManager::QUIT_STAGES> PlayerManager::quitTimes_;
+bool PlayerManager::snapshotDirty_ = true;
+uint64_t PlayerManager::snapshotVersion_ = 0;
+RcuCell<AuthSnapshot> PlayerManager::snapshot_;
 endstone::Plugin* PlayerManager::plugin_ = nullptr;
 const std::chrono::seconds PlayerManager::KICK_DELAY = std::chrono::seconds(140); // 2 минуты 20 секунд
 const std::chrono::seconds PlayerManager::REMINDER_INTERVAL = std::chrono::seconds(60); // 1 минута
 const std::chrono::seconds PlayerManager::AUTH_TIMEOUT = std::chrono::seconds(60); // 60 секунд
 const std::chrono::seconds PlayerManager::AUTH_REMINDER_INTERVAL = std::chrono::seconds(15); // 15 секунд
+const std::chrono::seconds PlayerManager::AUTH_REMINDER_BUCKET = std::chrono::seconds(5);
+const std::chrono::seconds PlayerManager::AUTH_REMINDER_GRACE = std::chrono::seconds(5);
+
+// Debug trace of a player position, callers check the level first
+static void traceLocation(std::string_view event, endstone::Player* pl, const endstone::Location& loc) {
+    Log::write(LogLevel::Debug, event,
+               {{"player", pl->getName()}, {"x", loc.getX()}, {"y", loc.getY()}, {"z", loc.getZ()},
+                {"yaw", loc.getYaw()}, {"pitch", loc.getPitch()}});
+}
+
+std::optional<endstone::UUID> PlayerManager::parseUUID(std::string_view text) {
+    // Hyphens may sit anywhere, as before; the digits are gathered on the stack
+    char digits[32];
+    size_t count = 0;
+    for (char c : text) {
+        if (c == '-') continue;
+        if (count == sizeof(digits)) return std::nullopt;
+        digits[count++] = c;
+    }
 
-// Helper function to parse UUID from string
-endstone::UUID PlayerManager::parseUUIDFromString(const std::string& uuidStr) {
     endstone::UUID result;
-    
-    // Remove hyphens from UUID string and parse as hex
-    std::string cleanUuidStr = uuidStr;
-    cleanUuidStr.erase(std::remove(cleanUuidStr.begin(), cleanUuidStr.end(), '-'), cleanUuidStr.end());
-    
-    if (cleanUuidStr.length() == 32) {
-        uint64_t high = std::stoull(cleanUuidStr.substr(0, 16), nullptr, 16);
-        uint64_t low = std::stoull(cleanUuidStr.substr(16, 16), nullptr, 16);
-        // Create UUID by filling the byte array
-        for (int i = 0; i < 8; i++) {
-            result.data[i] = (high >> (8 * (7 - i))) & 0xFF;
-            result.data[8 + i] = (low >> (8 * (7 - i))) & 0xFF;
-        }
-    } else {
-        // Fallback to a default UUID if parsing fails - all zeros
-        for (int i = 0; i < 16; i++) {
-            result.data[i] = 0;
-        }
+    if (!hex::decode(std::string_view(digits, count), result.data, sizeof(result.data))) {
+        return std::nullopt;
     }
-    
     return result;
 }
 
+// Helper function to parse UUID from string
+endstone::UUID PlayerManager::parseUUIDFromString(const std::string& uuidStr) {
+    // Fallback to a default UUID if parsing fails - all zeros
+    return parseUUID(uuidStr).value_or(endstone::UUID{});
+}
+
 void PlayerManager::setPlugin(endstone::Plugin* plugin) {
     plugin_ = plugin;
 }
 
+endstone::Plugin* PlayerManager::getPlugin() {
+    return plugin_;
+}
+
+void PlayerManager::startTimers() {
+    stopTimers();
+    timers_.schedule(AUTH_REMINDER_INTERVAL.count() * 20, Handle{}, TIMER_AUTH_BROADCAST);
+}
+
+void PlayerManager::stopTimers() {
+    timers_.clear();
+}
+
+void PlayerManager::tick() {
+    // Deadlines fire first so a timed-out player is kicked rather than admitted
+    timers_.advance(onTimer);
+    processAdmissions();
+
+    if (snapshotDirty_) {
+        publishSnapshot();
+    } else {
+        snapshot_.reclaim();
+    }
+}
+
+static bool uuidLess(const endstone::UUID& a, const endstone::UUID& b) {
+    return std::memcmp(a.data, b.data, sizeof(a.data)) < 0;
+}
+
+const AuthSnapshot::Entry* AuthSnapshot::find(const endstone::UUID& uuid) const {
+    auto it = std::lower_bound(players.begin(), players.end(), uuid,
+                               [](const Entry& entry, const endstone::UUID& key) { return uuidLess(entry.uuid, key); });
+    return it != players.end() && it->uuid == uuid ? &*it : nullptr;
+}
+
+void PlayerManager::publishSnapshot() {
+    auto snapshot = std::make_unique<AuthSnapshot>();
+    snapshot->version = ++snapshotVersion_;
+    snapshot->players.reserve(players_.size());
+    for (size_t i = 0; i < players_.size(); i++) {
+        Handle handle = players_.handleAt(i);
+        const PlayerData& data = *players_.get(handle);
+        AuthSnapshot::Entry entry;
+        entry.uuid = data.uuid;
+        entry.account = data.name;
+        entry.flags = flags_[handle.index];
+        entry.state = lifecycle_[handle.index].state;
+        entry.inLimbo = limbo_[handle.index] != nullptr;
+        snapshot->limbo += entry.inLimbo;
+        snapshot->authenticated += (entry.flags & AUTH_AUTHENTICATED) != 0;
+        snapshot->players.push_back(std::move(entry));
+    }
+    std::sort(snapshot->players.begin(), snapshot->players.end(),
+              [](const AuthSnapshot::Entry& a, const AuthSnapshot::Entry& b) { return uuidLess(a.uuid, b.uuid); });
+
+    snapshot_.publish(std::move(snapshot));
+    snapshotDirty_ = false;
+}
+
+const AuthSnapshot* PlayerManager::getSnapshot() {
+    static const AuthSnapshot empty;
+    const AuthSnapshot* snapshot = snapshot_.load();
+    return snapshot ? snapshot : &empty;
+}
+
+uint64_t PlayerManager::getSnapshotVersion() {
+    return snapshotVersion_;
+}
+
+size_t PlayerManager::getRetiredSnapshots() {
+    return snapshot_.retired();
+}
+
+bool PlayerManager::hasLeft(const endstone::UUID& uuid, uint64_t since) {
+    Epoch::Guard guard;
+    const AuthSnapshot* snapshot = getSnapshot();
+    return snapshot->version > since && !snapshot->find(uuid);
+}
+
+void PlayerManager::cancelTimer(TimingWheel::TimerId& id) {
+    timers_.cancel(id);
+    id = TimingWheel::TimerId{};
+}
+
+void PlayerManager::onTimer(Handle owner, uint8_t kind) {
+    if (kind == TIMER_AUTH_BROADCAST) {
+        timers_.schedule(AUTH_REMINDER_INTERVAL.count() * 20, Handle{}, TIMER_AUTH_BROADCAST);
+        WorkScheduler::post(WorkQueue::Reminders, broadcastAuthReminders);
+        return;
+    }
+
+    // Timers of players that already left are cancelled, this is only a guard
+    if (!players_.contains(owner) || !limbo_[owner.index]) return;
+    LimboState& limbo = *limbo_[owner.index];
+    endstone::Player* pl = limbo.player;
+    if (!pl) return;
+
+    // Kicking unloads the player, so limbo must not be touched afterwards
+    switch (kind) {
+    case TIMER_KICK:
+        limbo.kickTimer = TimingWheel::TimerId{};
+        kickUnregisteredPlayer(pl);
+        break;
+    case TIMER_REMINDER:
+        limbo.reminderTimer = timers_.schedule(REMINDER_INTERVAL.count() * 20, owner, TIMER_REMINDER);
+        sendRegistrationReminder(pl);
+        break;
+    case TIMER_AUTH_TIMEOUT:
+        limbo.authTimer = TimingWheel::TimerId{};
+        if (!isPlayerAuthenticated(pl)) {
+            pl->kick(msg(MsgId::AuthTimeout));
+        }
+        break;
+    }
+}
+
+void PlayerManager::processAdmissions() {
+    if (admission_.empty()) return;
+
+    const auto& config = Config::getInstance();
+
+    // Prepared players are in the auth area and their logins will cost
+    // restores on the tick later on. The queue may hold stale handles, so
+    // this is counted from the limbo states rather than derived from it.
+    const size_t maxWaiting = static_cast<size_t>(std::max(config.admission_max_waiting, 0));
+    size_t prepared = preparedCount_;
+
+    // Always admit at least one player so the queue drains even on slow ticks
+    auto start = std::chrono::steady_clock::now();
+    auto budget = std::chrono::microseconds(std::max(config.admission_budget_us, 0));
+    while (!admission_.empty()) {
+        // Held players stay gated in Limbo and are admitted once others log in or leave
+        if (maxWaiting > 0 && prepared >= maxWaiting) {
+            admissionStats_.held++;
+            break;
+        }
+        Handle handle = admission_.front();
+        admission_.pop_front();
+        // Players who left or already logged in are skipped
+        if (players_.contains(handle) && limbo_[handle.index] && !(flags_[handle.index] & AUTH_AUTHENTICATED)) {
+            prepareLimbo(limbo_[handle.index]->player);
+            admissionStats_.admitted++;
+            prepared = preparedCount_;
+        }
+        if (std::chrono::steady_clock::now() - start >= budget) break;
+    }
+
+    auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    admissionStats_.queued = admission_.size();
+    admissionStats_.lastTickUs = static_cast<uint64_t>(cost);
+    admissionStats_.maxTickUs = std::max(admissionStats_.maxTickUs, admissionStats_.lastTickUs);
+}
+
+PlayerManager::AdmissionStats PlayerManager::getAdmissionStats() {
+    return admissionStats_;
+}
+
+void PlayerManager::describeStats(std::vector<std::string>& lines) {
+    lines.push_back(msg(MsgId::StatsPlayers, players_.size(), getLimboCount(), getTimerCount()));
+    lines.push_back(msg(MsgId::StatsSnapshot, getSnapshotVersion(), getRetiredSnapshots()));
+    lines.push_back(msg(MsgId::StatsAdmission, admissionStats_.queued, admissionStats_.maxQueued,
+                        admissionStats_.admitted, admissionStats_.held, admissionStats_.lastTickUs,
+                        admissionStats_.maxTickUs));
+
+    auto describeStages = [&lines](MsgId title, const std::vector<StageStats>& stages) {
+        std::string items;
+        for (const auto& stage : stages) {
+            items += msg(MsgId::StatsStageItem, stage.name, stage.runs ? stage.totalUs / stage.runs : 0, stage.maxUs);
+        }
+        lines.push_back(msg(title, items));
+    };
+    describeStages(MsgId::StatsJoinStages, getJoinStageStats());
+    describeStages(MsgId::StatsQuitStages, getQuitStageStats());
+}
+
+void PlayerManager::broadcastAuthReminders() {
+    if (getLimboCount() == 0) return;
+
+    // Group players by remaining time, rounded up to a bucket boundary
+    const int bucketSeconds = static_cast<int>(AUTH_REMINDER_BUCKET.count());
+    const size_t bucketCount = static_cast<size_t>((AUTH_TIMEOUT.count() + bucketSeconds - 1) / bucketSeconds);
+    reminderBuckets_.resize(bucketCount);
+
+    auto now = std::chrono::steady_clock::now();
+    for (auto& limbo : limbo_) {
+        if (!limbo || !limbo->player || !limbo->authTimer.valid()) continue;
+        // Players who just joined have the welcome title on screen already
+        auto elapsed = now - limbo->authStart;
+        if (elapsed < AUTH_REMINDER_GRACE) continue;
+        auto timeLeft = AUTH_TIMEOUT.count() - std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
+        if (timeLeft <= 0) continue;
+        size_t index = std::min(static_cast<size_t>((timeLeft - 1) / bucketSeconds), bucketCount - 1);
+        reminderBuckets_[index].players.push_back(limbo->player);
+    }
+
+    // Strings are built once per non-empty bucket; player lists keep their capacity
+    for (size_t i = 0; i < reminderBuckets_.size(); i++) {
+        auto& bucket = reminderBuckets_[i];
+        if (bucket.players.empty()) continue;
+        int secondsLeft = static_cast<int>(i + 1) * bucketSeconds;
+        formatAuthReminder(bucket, secondsLeft);
+        for (auto* player : bucket.players) {
+            deliverAuthReminder(player, bucket, secondsLeft);
+        }
+        bucket.players.clear();
+    }
+}
+
+void PlayerManager::formatAuthReminder(ReminderBucket& bucket, int secondsLeft) {
+    bucket.message = msg(MsgId::AuthTimeLeft, secondsLeft);
+    bucket.title = msg(secondsLeft <= 30 ? MsgId::AuthTitleUrgent : MsgId::AuthTitleNormal);
+    bucket.subtitle = msg(MsgId::AuthSubtitleTimeLeft, secondsLeft);
+}
+
+void PlayerManager::deliverAuthReminder(endstone::Player* pl, const ReminderBucket& bucket, int secondsLeft) {
+    pl->sendMessage(bucket.message);
+    Messages::send(*pl, MsgId::AuthHints);
+
+    // Send title/subtitle for visual notification
+    if (secondsLeft <= 30) {
+        pl->sendTitle(bucket.title, bucket.subtitle, 0, 60, 20);
+    } else {
+        pl->sendTitle(bucket.title, bucket.subtitle, 0, 40, 10);
+    }
+}
+
 endstone::UUID PlayerManager::getRealUUID(endstone::Player* pl) {
     return pl->getUniqueId();
 }
 
 endstone::UUID PlayerManager::getFakeUUID(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it != playerDataMap.end() && it->second.valid) {
-        return it->second.fakeUUID;
+    PlayerData* found = find(pl);
+    if (found && hasAccount(pl)) {
+        return found->fakeUUID;
     }
     return pl->getUniqueId();
 }
@@ -65,62 +335,322 @@ std::string PlayerManager::getFakeDBkey(const std::string& real) {
 }
 
 void PlayerManager::setFakeDBkey(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it != playerDataMap.end()) {
-        it->second.fakeDBkey = getFakeDBkey(pl->getUniqueId().str());
+    PlayerData* found = find(pl);
+    if (found) {
+        found->fakeDBkey = getFakeDBkey(pl->getUniqueId().str());
     }
 }
 
-void PlayerManager::setPlayerData(endstone::Player* pl, PlayerData& data) {
-    playerDataMap[pl] = data;
+PlayerData* PlayerManager::find(endstone::Player* pl) {
+    return players_.get(index_.find(pl->getUniqueId()));
+}
+
+uint8_t* PlayerManager::findFlags(endstone::Player* pl) {
+    Handle handle = index_.find(pl->getUniqueId());
+    return players_.contains(handle) ? &flags_[handle.index] : nullptr;
+}
+
+LimboState* PlayerManager::findLimbo(endstone::Player* pl) {
+    Handle handle = index_.find(pl->getUniqueId());
+    return players_.contains(handle) ? limbo_[handle.index].get() : nullptr;
+}
+
+LimboState& PlayerManager::enterLimbo(endstone::Player* pl) {
+    Handle handle = index_.find(pl->getUniqueId());
+    auto& limbo = limbo_[handle.index];
+    if (!limbo) {
+        if (limboPool_.empty()) {
+            limbo = std::make_unique<LimboState>();
+        } else {
+            limbo = std::move(limboPool_.back());
+            limboPool_.pop_back();
+        }
+        limbo->player = pl;
+        limbo->joinTime = std::chrono::steady_clock::now();
+        snapshotDirty_ = true;
+    }
+    return *limbo;
+}
+
+void PlayerManager::leaveLimbo(endstone::Player* pl) {
+    Handle handle = index_.find(pl->getUniqueId());
+    if (players_.contains(handle) && limbo_[handle.index]) {
+        auto& limbo = *limbo_[handle.index];
+        for (auto* id : {&limbo.kickTimer, &limbo.reminderTimer, &limbo.authTimer}) {
+            cancelTimer(*id);
+        }
+        if (limbo.prepared) {
+            preparedCount_--;
+        }
+        limbo.reset();
+        limboPool_.push_back(std::move(limbo_[handle.index]));
+        snapshotDirty_ = true;
+    }
+}
+
+AuthState PlayerManager::getAuthState(endstone::Player* pl) {
+    Handle handle = index_.find(pl->getUniqueId());
+    return players_.contains(handle) ? lifecycle_[handle.index].state : AuthState::LoggingOut;
+}
+
+bool PlayerManager::transition(endstone::Player* pl, AuthState to) {
+    Handle handle = index_.find(pl->getUniqueId());
+    if (!players_.contains(handle)) return false;
+
+    Lifecycle& lifecycle = lifecycle_[handle.index];
+    if (lifecycle.state == to) return true;
+    if (!isValidTransition(lifecycle.state, to)) {
+        AuthStateStats::reject();
+        LOG_WARNING("auth.invalid_transition", {"player", pl->getName()}, {"from", authStateName(lifecycle.state)},
+                    {"to", authStateName(to)});
+        return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    AuthStateStats::record(lifecycle.state, to, now - lifecycle.since);
+    lifecycle = Lifecycle{to, now};
+    snapshotDirty_ = true;
+    return true;
+}
+
+uint8_t PlayerManager::getAuthFlags(endstone::Player* pl) {
+    uint8_t* flags = findFlags(pl);
+    return flags ? *flags : 0;
+}
+
+void PlayerManager::setAuthFlags(endstone::Player* pl, uint8_t flags) {
+    if (uint8_t* current = findFlags(pl)) {
+        *current |= flags;
+        snapshotDirty_ = true;
+    }
+}
+
+bool PlayerManager::hasAccount(endstone::Player* pl) {
+    return getAuthFlags(pl) & AUTH_VALID;
+}
+
+size_t PlayerManager::getLimboCount() {
+    return static_cast<size_t>(AuthStateStats::count(AuthState::Limbo) + AuthStateStats::count(AuthState::Authenticating));
+}
+
+size_t PlayerManager::getTimerCount() {
+    return timers_.size();
+}
+
+PlayerManager::Handle PlayerManager::getHandle(endstone::Player* pl) {
+    return index_.find(pl->getUniqueId());
+}
+
+PlayerData* PlayerManager::get(Handle handle) {
+    return players_.get(handle);
+}
+
+void PlayerManager::setPlayerData(endstone::Player* pl, PlayerData&& data) {
+    // Replace in place so the player's handle stays valid
+    data.uuid = pl->getUniqueId();
+    snapshotDirty_ = true;
+    if (PlayerData* found = find(pl)) {
+        *found = std::move(data);
+        return;
+    }
+    endstone::UUID uuid = data.uuid;
+    Handle handle = players_.insert(std::move(data));
+    if (handle.index >= flags_.size()) {
+        flags_.resize(handle.index + 1, 0);
+        limbo_.resize(handle.index + 1);
+        lifecycle_.resize(handle.index + 1);
+    }
+    flags_[handle.index] = 0;
+    lifecycle_[handle.index] = Lifecycle{AuthState::Joining, std::chrono::steady_clock::now()};
+    AuthStateStats::enter(AuthState::Joining);
+    index_.insert(uuid, handle);
 }
 
 void PlayerManager::loadPlayer(endstone::Player* pl) {
-    // Initialize player data when they join
+    runStages(joinStages_, joinTimes_.data(), JOIN_STAGES, pl);
+}
+
+void PlayerManager::unloadPlayer(endstone::Player* pl) {
+    runStages(quitStages_, quitTimes_.data(), QUIT_STAGES, pl);
+}
+
+void PlayerManager::runStages(const Stage* stages, StageTimes* times, size_t count, endstone::Player* pl) {
+    for (size_t i = 0; i < count; i++) {
+        auto start = std::chrono::steady_clock::now();
+        bool next = stages[i].run(pl);
+        auto us = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+        times[i].runs++;
+        times[i].totalUs += us;
+        times[i].maxUs = std::max(times[i].maxUs, us);
+        if (!next) break;
+    }
+}
+
+std::vector<PlayerManager::StageStats> PlayerManager::collectStageStats(const Stage* stages, const StageTimes* times,
+                                                                        size_t count) {
+    std::vector<StageStats> stats(count);
+    for (size_t i = 0; i < count; i++) {
+        stats[i].name = stages[i].name;
+        stats[i].runs = times[i].runs;
+        stats[i].totalUs = times[i].totalUs;
+        stats[i].maxUs = times[i].maxUs;
+    }
+    return stats;
+}
+
+std::vector<PlayerManager::StageStats> PlayerManager::getJoinStageStats() {
+    return collectStageStats(joinStages_, joinTimes_.data(), JOIN_STAGES);
+}
+
+std::vector<PlayerManager::StageStats> PlayerManager::getQuitStageStats() {
+    return collectStageStats(quitStages_, quitTimes_.data(), QUIT_STAGES);
+}
+
+bool PlayerManager::joinRecover(endstone::Player* pl) {
+    // State journaled before a crash goes back before anything else is saved
+    auto record = LimboJournal::take(getId(pl));
+    if (!record) return true;
+
+    if (record->hasLocation) {
+        endstone::Dimension* dimension = nullptr;
+        if (auto* level = plugin_ ? plugin_->getServer().getLevel() : nullptr) {
+            dimension = level->getDimension(record->dimension);
+        }
+        if (!dimension) {
+            dimension = pl->getLocation().getDimension();
+        }
+        pl->teleport(endstone::Location(dimension, record->x, record->y, record->z, record->yaw, record->pitch));
+    }
+
+    auto& inventory = pl->getInventory();
+    inventory.clear();
+    size_t lossy = 0;
+    for (const auto& item : record->items) {
+        endstone::ItemStack stack(item.type, item.amount, item.data);
+        inventory.setItem(item.slot, &stack);
+        if (item.lossy) {
+            // The journal has no metadata, the item comes back plain
+            LOG_WARNING("limbo.recovered_without_meta", {"player", pl->getName()}, {"slot", item.slot},
+                        {"type", item.type});
+            lossy++;
+        }
+    }
+
+    LOG_INFO("limbo.recovered", {"player", pl->getName()}, {"items", record->items.size()}, {"lossy", lossy});
+    return true;
+}
+
+bool PlayerManager::joinResume(endstone::Player* pl) {
+    // A valid resume ticket from a recent session authenticates without limbo
+    if (!SessionTickets::redeem(pl)) return true;
+
+    // The account is read on the I/O pool and the resume finishes on a later
+    // tick. Until then the player waits in Joining with chat and commands gated.
+    joinRecord(pl);
+    return !AccountManager::resumeSession(*pl);
+}
+
+bool PlayerManager::joinRecord(endstone::Player* pl) {
     PlayerData data;
     data.id = getId(pl);
-    data.valid = false;
-    data.isRegistered = false;
-    data.isAuthenticated = false;
-    data.joinTime = std::chrono::steady_clock::now();
-    data.isFrozen = false;
-    playerDataMap[pl] = data;
-    
-    // Start authorization process
+    data.uuid = pl->getUniqueId();
+    setPlayerData(pl, std::move(data));
+    return true;
+}
+
+bool PlayerManager::joinGate(endstone::Player* pl) {
     startAuthorizationProcess(pl);
+    return true;
 }
 
-void PlayerManager::unloadPlayer(endstone::Player* pl) {
+bool PlayerManager::quitLeave(endstone::Player* pl) {
+    transition(pl, AuthState::LoggingOut);
+    return true;
+}
+
+bool PlayerManager::quitTicket(endstone::Player* pl) {
+    if (isPlayerAuthenticated(pl)) {
+        SessionTickets::issue(pl, getPlayerData(pl).name);
+    }
+    return true;
+}
+
+bool PlayerManager::quitTimers(endstone::Player* pl) {
     stopRegistrationTimer(pl);
     stopAuthorizationTimer(pl);
-    playerDataMap.erase(pl);
+    return true;
+}
+
+bool PlayerManager::quitLimbo(endstone::Player* pl) {
+    // Put the full snapshot back before the state is released, which also
+    // closes the journal entry. The journal keeps only type, amount and data
+    // per item and is meant for crash recovery.
+    restorePlayerState(pl);
+    leaveLimbo(pl);
+    return true;
+}
+
+bool PlayerManager::quitRecord(endstone::Player* pl) {
+    // Erasing bumps the slot generation, so handles held by pending callbacks go stale
+    auto uuid = pl->getUniqueId();
+    Handle handle = index_.find(uuid);
+    if (players_.contains(handle)) {
+        AuthStateStats::leave(lifecycle_[handle.index].state);
+    }
+    if (players_.erase(handle)) {
+        flags_[handle.index] = 0;
+    }
+    index_.erase(uuid);
+    snapshotDirty_ = true;
+    return true;
 }
 
 const PlayerData& PlayerManager::getPlayerData(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it != playerDataMap.end()) {
-        return it->second;
+    PlayerData* found = find(pl);
+    if (found) {
+        return *found;
     }
     static PlayerData emptyData;
     return emptyData;
 }
 
 endstone::Player* PlayerManager::getPlayerByUUID(const endstone::UUID& uuid) {
-    // This would require access to the server's player list
-    // For now, return nullptr as this is a simplified implementation
-    return nullptr;
+    if (!plugin_) return nullptr;
+    return plugin_->getServer().getPlayer(uuid);
 }
 
-const std::unordered_map<endstone::Player*, PlayerData>& PlayerManager::getAllData() {
-    return playerDataMap;
+const SlotMap<PlayerData>& PlayerManager::getAllData() {
+    return players_;
 }
 
-void PlayerManager::clearAllData() {
-    for (auto& pair : playerDataMap) {
-        stopRegistrationTimer(pair.first);
-        stopAuthorizationTimer(pair.first);
+void PlayerManager::restoreLimboPlayers() {
+    size_t restored = 0;
+    for (const auto& limbo : limbo_) {
+        if (limbo && limbo->player && limbo->prepared) {
+            restorePlayerState(limbo->player);
+            restored++;
+        }
+    }
+    if (restored > 0) {
+        LOG_INFO("limbo.restored_on_shutdown", {"players", restored});
     }
-    playerDataMap.clear();
+}
+
+void PlayerManager::clearAllData() {
+    timers_.clear();
+    admission_.clear();
+    admissionStats_.queued = 0;
+    preparedCount_ = 0;
+    players_.clear();
+    index_.clear();
+    flags_.clear();
+    limbo_.clear();
+    limboPool_.clear();
+    lifecycle_.clear();
+    AuthStateStats::reset();
+    // Readers see nobody online from here on
+    publishSnapshot();
 }
 
 std::string PlayerManager::getId(endstone::Player* pl) {
@@ -130,15 +660,16 @@ std::string PlayerManager::getId(endstone::Player* pl) {
 void PlayerManager::reconnect(endstone::Player* pl) {
     // In Endstone, we can't force a player to reconnect like in LeviLamina
     // Instead, we'll just send a message asking them to reconnect
-    pl->sendMessage(endstone::ColorFormat::Yellow + "Please reconnect to the server to complete the login process.");
+    pl->sendMessage(msg(MsgId::Reconnect));
 }
 
 // New registration system implementation
 
 void PlayerManager::freezePlayer(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it != playerDataMap.end()) {
-        it->second.isFrozen = true;
+    uint8_t* flags = findFlags(pl);
+    if (flags) {
+        *flags |= AUTH_FROZEN;
+        snapshotDirty_ = true;
         
         // Set player as unable to move
         pl->setAllowFlight(false);
@@ -151,16 +682,15 @@ void PlayerManager::freezePlayer(endstone::Player* pl) {
         location.setY(256.0f); // High in the sky
         pl->teleport(location);
         
-        pl->sendMessage(endstone::ColorFormat::Red + "Вы заморожены! Пожалуйста, зарегистрируйтесь чтобы играть.");
-        pl->sendMessage(endstone::ColorFormat::Gold + "Используйте /register <ник> <пароль> <подтверждение> для регистрации");
-        pl->sendMessage(endstone::ColorFormat::Gold + "Или /login <ник> <пароль> для входа в существующий аккаунт");
+        Messages::send(*pl, MsgId::Frozen);
     }
 }
 
 void PlayerManager::unfreezePlayer(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it != playerDataMap.end()) {
-        it->second.isFrozen = false;
+    uint8_t* flags = findFlags(pl);
+    if (flags) {
+        *flags &= ~AUTH_FROZEN;
+        snapshotDirty_ = true;
         
         // Restore normal movement
         pl->setWalkSpeed(0.2f);
@@ -171,130 +701,74 @@ void PlayerManager::unfreezePlayer(endstone::Player* pl) {
         location.setY(64.0f); // Ground level
         pl->teleport(location);
         
-        pl->sendMessage(endstone::ColorFormat::Green + "Вы успешно разморожены! Добро пожаловать на сервер!");
+        pl->sendMessage(msg(MsgId::Unfrozen));
     }
 }
 
 bool PlayerManager::isPlayerFrozen(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    return it != playerDataMap.end() && it->second.isFrozen;
+    return getAuthFlags(pl) & AUTH_FROZEN;
 }
 
 void PlayerManager::startRegistrationTimer(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it == playerDataMap.end()) return;
-    
-    auto& data = it->second;
-    
+    if (!find(pl)) return;
+
     // Stop any existing timers
     stopRegistrationTimer(pl);
+    auto& data = enterLimbo(pl);
     
-    // Create kick task
-    if (plugin_) {
-        std::string playerId = pl->getUniqueId().str();
-        data.kickTask = plugin_->getServer().getScheduler().runTaskLater(
-            *plugin_,
-            [playerId]() {
-                // Find player by ID instead of using raw pointer
-                if (plugin_) {
-                    auto& server = plugin_->getServer();
-                    auto* player = server.getPlayer(PlayerManager::parseUUIDFromString(playerId));
-                    if (player) {
-                        kickUnregisteredPlayer(player);
-                    }
-                }
-            },
-            KICK_DELAY.count() * 20 // Convert to ticks (20 ticks = 1 second)
-        );
-        
-        // Create reminder task
-        data.reminderTask = plugin_->getServer().getScheduler().runTaskTimer(
-            *plugin_,
-            [playerId]() {
-                // Find player by ID instead of using raw pointer
-                if (plugin_) {
-                    auto& server = plugin_->getServer();
-                    auto* player = server.getPlayer(PlayerManager::parseUUIDFromString(playerId));
-                    if (player) {
-                        sendRegistrationReminder(player);
-                    }
-                }
-            },
-            REMINDER_INTERVAL.count() * 20, // Initial delay
-            REMINDER_INTERVAL.count() * 20  // Repeat interval
-        );
-    }
+    // Kick deadline and repeating reminder, both on the shared wheel
+    Handle handle = getHandle(pl);
+    data.kickTimer = timers_.schedule(KICK_DELAY.count() * 20, handle, TIMER_KICK); // 20 ticks = 1 second
+    data.reminderTimer = timers_.schedule(REMINDER_INTERVAL.count() * 20, handle, TIMER_REMINDER);
 }
 
 void PlayerManager::stopRegistrationTimer(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it == playerDataMap.end()) return;
-    
-    auto& data = it->second;
-    
-    // Cancel kick task
-    if (data.kickTask) {
-        data.kickTask->cancel();
-        data.kickTask.reset();
-    }
+    LimboState* limbo = findLimbo(pl);
+    if (!limbo) return;
     
-    // Cancel reminder task
-    if (data.reminderTask) {
-        data.reminderTask->cancel();
-        data.reminderTask.reset();
-    }
+    cancelTimer(limbo->kickTimer);
+    cancelTimer(limbo->reminderTimer);
 }
 
 void PlayerManager::kickUnregisteredPlayer(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it == playerDataMap.end()) return;
-    
-    auto& data = it->second;
+    if (!find(pl)) return;
     
-    if (!data.isRegistered) {
-        pl->kick(endstone::ColorFormat::Red + "Вы были кикнуты за то, что не зарегистрировались в течение 2 минут 20 секунд!");
+    if (!isPlayerRegistered(pl)) {
+        pl->kick(msg(MsgId::RegistrationKick));
     }
 }
 
 void PlayerManager::sendRegistrationReminder(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it == playerDataMap.end()) return;
+    if (!find(pl)) return;
     
-    auto& data = it->second;
-    
-    if (!data.isRegistered) {
+    if (!isPlayerRegistered(pl)) {
         auto timeLeft = getTimeUntilKick(pl);
         auto minutes = std::chrono::duration_cast<std::chrono::minutes>(timeLeft).count();
         auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeLeft % std::chrono::minutes(1)).count();
         
-        std::ostringstream msg;
-        msg << endstone::ColorFormat::Yellow << "Пожалуйста, зарегистрируйтесь! У вас осталось " 
-            << minutes << " минут " << seconds << " секунд.";
-        
-        pl->sendMessage(msg.str());
-        pl->sendMessage(endstone::ColorFormat::Gold + "/register <ник> <пароль> <подтверждение> или /login <ник> <пароль>");
+        Messages::send(*pl, MsgId::RegistrationTimeLeft, minutes, seconds);
     }
 }
 
 bool PlayerManager::isPlayerRegistered(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    return it != playerDataMap.end() && it->second.isRegistered;
+    return getAuthFlags(pl) & AUTH_REGISTERED;
 }
 
 void PlayerManager::markPlayerAsRegistered(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it != playerDataMap.end()) {
-        it->second.isRegistered = true;
+    uint8_t* flags = findFlags(pl);
+    if (flags) {
+        *flags |= AUTH_REGISTERED;
+        snapshotDirty_ = true;
         stopRegistrationTimer(pl);
         unfreezePlayer(pl);
     }
 }
 
 std::chrono::seconds PlayerManager::getTimeUntilKick(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it == playerDataMap.end()) return std::chrono::seconds(0);
+    LimboState* limbo = findLimbo(pl);
+    if (!limbo) return std::chrono::seconds(0);
     
-    auto& data = it->second;
+    auto& data = *limbo;
     auto now = std::chrono::steady_clock::now();
     auto elapsed = now - data.joinTime;
     auto remaining = KICK_DELAY - elapsed;
@@ -309,22 +783,43 @@ std::chrono::seconds PlayerManager::getTimeUntilKick(endstone::Player* pl) {
 // New authorization system implementation
 
 void PlayerManager::startAuthorizationProcess(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it == playerDataMap.end()) return;
-    
-    auto& data = it->second;
-    
-    // Debug output - show initial location
-    if (plugin_) {
-        endstone::Location initialLocation = pl->getLocation();
-        std::ostringstream msg;
-        msg << "Starting authorization process for " << pl->getName() << ": initial location=(" 
-            << initialLocation.getX() << "," << initialLocation.getY() << "," << initialLocation.getZ() << ")";
-        plugin_->getLogger().info(msg.str());
+    if (!find(pl)) return;
+
+    // Resumed sessions are already authenticated
+    if (isPlayerAuthenticated(pl)) return;
+
+    // Already waiting in limbo, don't queue the player twice
+    if (findLimbo(pl)) return;
+
+    // Gating is immediate: without AUTH_AUTHENTICATED chat and commands are
+    // blocked already. The deadline starts on admission, so players held by
+    // admission_max_waiting don't lose their time in the queue.
+    // Limbo state is allocated here and freed once the player logs in or leaves.
+    enterLimbo(pl);
+    transition(pl, AuthState::Limbo);
+
+    const int maxWaiting = Config::getInstance().admission_max_waiting;
+    if (maxWaiting > 0 && preparedCount_ >= static_cast<size_t>(maxWaiting)) {
+        Messages::send(*pl, MsgId::AuthQueued);
     }
+
+    // The expensive part waits for the admission queue, see processAdmissions()
+    admission_.push_back(getHandle(pl));
+    admissionStats_.queued = admission_.size();
+    admissionStats_.maxQueued = std::max(admissionStats_.maxQueued, admissionStats_.queued);
+}
+
+void PlayerManager::prepareLimbo(endstone::Player* pl) {
+    LimboState* limbo = findLimbo(pl);
+    if (!limbo || limbo->prepared) return;
+
+    if (Log::enabled(LogLevel::Debug)) traceLocation("auth.start", pl, pl->getLocation());
     
     // Save player state FIRST - this saves the ORIGINAL spawn location BEFORE any teleportation
     savePlayerState(pl);
+    limbo->prepared = true;
+    preparedCount_++;
+    LimboJournal::recordEnter(getId(pl), *limbo);
     
     // Clear inventory
     auto& inventory = pl->getInventory();
@@ -337,40 +832,21 @@ void PlayerManager::startAuthorizationProcess(endstone::Player* pl) {
     location.setY(15000.0f);
     pl->teleport(location);
     
-    // Debug output - confirm teleportation
-    if (plugin_) {
-        endstone::Location newLocation = pl->getLocation();
-        std::ostringstream msg;
-        msg << "Player " << pl->getName() << " teleported to authorization area: (" 
-            << newLocation.getX() << "," << newLocation.getY() << "," << newLocation.getZ() << ")";
-        plugin_->getLogger().info(msg.str());
-    }
+    if (Log::enabled(LogLevel::Debug)) traceLocation("auth.limbo_teleport", pl, pl->getLocation());
     
     // Send title message
-    pl->sendTitle("Пожалуйста, зарегистрируйтесь", "для продолжения игры", 10, 120, 20);
-    
-    // Start authorization timer
-    startAuthorizationTimer(pl);
+    pl->sendTitle(msg(MsgId::AuthTitle), msg(MsgId::AuthSubtitle), 10, 120, 20);
     
     // Send initial message
-    pl->sendMessage(endstone::ColorFormat::Yellow + "Добро пожаловать на сервер!");
-    pl->sendMessage(endstone::ColorFormat::Gold + "Пожалуйста, зарегистрируйтесь или войдите в аккаунт чтобы играть.");
-    pl->sendMessage(endstone::ColorFormat::Gold + "Используйте /register <пароль> <подтверждение> для регистрации");
-    pl->sendMessage(endstone::ColorFormat::Gold + "Или /login <пароль> для входа в существующий аккаунт");
+    Messages::send(*pl, MsgId::Welcome);
+    startAuthorizationTimer(pl);
 }
 
 void PlayerManager::completeAuthorizationProcess(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it == playerDataMap.end()) return;
+    PlayerData* found = find(pl);
+    if (!found) return;
     
-    // Debug output
-    if (plugin_) {
-        endstone::Location currentLocation = pl->getLocation();
-        std::ostringstream msg;
-        msg << "Completing authorization process for " << pl->getName() << ": current location=(" 
-            << currentLocation.getX() << "," << currentLocation.getY() << "," << currentLocation.getZ() << ")";
-        plugin_->getLogger().info(msg.str());
-    }
+    if (Log::enabled(LogLevel::Debug)) traceLocation("auth.complete", pl, pl->getLocation());
     
     // Stop authorization timer
     stopAuthorizationTimer(pl);
@@ -380,81 +856,48 @@ void PlayerManager::completeAuthorizationProcess(endstone::Player* pl) {
     
     // Mark player as authenticated
     markPlayerAsAuthenticated(pl);
+    transition(pl, AuthState::Authenticated);
+    leaveLimbo(pl);
     
     // Send welcome message
-    pl->sendMessage(endstone::ColorFormat::Green + "Вы успешно авторизованы! Добро пожаловать на сервер!");
+    pl->sendMessage(msg(MsgId::AuthSuccess));
     
-    // Final debug output
-    if (plugin_) {
-        endstone::Location finalLocation = pl->getLocation();
-        std::ostringstream msg;
-        msg << "Authorization completed for " << pl->getName() << ": final location=(" 
-            << finalLocation.getX() << "," << finalLocation.getY() << "," << finalLocation.getZ() << ")";
-        plugin_->getLogger().info(msg.str());
-    }
+    if (Log::enabled(LogLevel::Debug)) traceLocation("auth.completed", pl, pl->getLocation());
 }
 
 void PlayerManager::savePlayerState(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it == playerDataMap.end()) return;
+    LimboState* limbo = findLimbo(pl);
+    if (!limbo) return;
     
-    auto& data = it->second;
+    auto& data = *limbo;
     
     // Save original location and rotation BEFORE any teleportation
     endstone::Location currentLocation = pl->getLocation();
-    data.originalLocation = std::make_unique<endstone::Location>(currentLocation);
+    data.originalLocation.emplace(currentLocation);
     data.originalYaw = currentLocation.getYaw();
     data.originalPitch = currentLocation.getPitch();
     
-    // Debug output
-    if (plugin_) {
-        std::ostringstream msg;
-        msg << "Saving player state for " << pl->getName() << ": location=(" 
-            << currentLocation.getX() << "," << currentLocation.getY() << "," << currentLocation.getZ() 
-            << "), yaw=" << currentLocation.getYaw() << ", pitch=" << currentLocation.getPitch();
-        plugin_->getLogger().info(msg.str());
-    }
+    if (Log::enabled(LogLevel::Debug)) traceLocation("state.save", pl, currentLocation);
     
-    // Save inventory
-    data.savedInventory.clear();
-    auto& inventory = pl->getInventory();
-    for (int i = 0; i < inventory.getSize(); i++) {
-        auto item = inventory.getItem(i);
-        if (item) {
-            // Clone the item and store it as unique_ptr
-            data.savedInventory.push_back(std::make_unique<endstone::ItemStack>(*item));
-        }
-    }
+    // Save inventory by slot, into buffers kept from earlier players
+    data.savedInventory.capture(pl->getInventory());
 }
 
 void PlayerManager::restorePlayerState(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it == playerDataMap.end()) return;
+    // Players who log in before admission still have their own state, nothing to restore
+    LimboState* limbo = findLimbo(pl);
+    if (!limbo || !limbo->prepared) return;
     
-    auto& data = it->second;
+    auto& data = *limbo;
     
-    // Debug output
-    if (plugin_) {
-        endstone::Location currentLocation = pl->getLocation();
-        std::ostringstream msg;
-        msg << "Restoring player state for " << pl->getName() << ": current location=(" 
-            << currentLocation.getX() << "," << currentLocation.getY() << "," << currentLocation.getZ() 
-            << "), yaw=" << currentLocation.getYaw() << ", pitch=" << currentLocation.getPitch();
-        plugin_->getLogger().info(msg.str());
-    }
+    if (Log::enabled(LogLevel::Debug)) traceLocation("state.restore", pl, pl->getLocation());
     
     // Restore location and rotation if available
     if (data.originalLocation) {
         auto& originalLoc = *data.originalLocation;
         
-        // Debug output
-        if (plugin_) {
-            std::ostringstream msg;
-            msg << "Teleporting player " << pl->getName() << " back to original location: (" 
-                << originalLoc.getX() << "," << originalLoc.getY() << "," << originalLoc.getZ() 
-                << "), yaw=" << data.originalYaw << ", pitch=" << data.originalPitch;
-            plugin_->getLogger().info(msg.str());
-        }
+        LOG_DEBUG("state.restore_target", {"player", pl->getName()}, {"x", originalLoc.getX()}, {"y", originalLoc.getY()},
+                  {"z", originalLoc.getZ()}, {"yaw", data.originalYaw}, {"pitch", data.originalPitch});
         
         // Create a new location with the original coordinates and rotation
         // Use the dimension from the original location, fallback to current if not available
@@ -487,22 +930,10 @@ void PlayerManager::restorePlayerState(endstone::Player* pl) {
             pl->teleport(restoreLocation);
         }
         
-        // Additional debug output
-        if (plugin_) {
-            endstone::Location newLocation = pl->getLocation();
-            std::ostringstream msg;
-            msg << "Player " << pl->getName() << " teleported successfully to: (" 
-                << newLocation.getX() << "," << newLocation.getY() << "," << newLocation.getZ() 
-                << "), yaw=" << newLocation.getYaw() << ", pitch=" << newLocation.getPitch();
-            plugin_->getLogger().info(msg.str());
-        }
+        if (Log::enabled(LogLevel::Debug)) traceLocation("state.restored", pl, pl->getLocation());
     } else {
         // Fallback: teleport to spawn location if no original location saved
-        if (plugin_) {
-            std::ostringstream msg;
-            msg << "No original location saved for player " << pl->getName() << ", teleporting to world spawn";
-            plugin_->getLogger().info(msg.str());
-        }
+        LOG_DEBUG("state.no_saved_location", {"player", pl->getName()});
         
         // Create a simple spawn location at ground level with current position
         endstone::Location currentLocation = pl->getLocation();
@@ -516,145 +947,52 @@ void PlayerManager::restorePlayerState(endstone::Player* pl) {
         );
         pl->teleport(spawnLocation);
         
-        if (plugin_) {
-            std::ostringstream msg;
-            msg << "Player " << pl->getName() << " teleported to fallback spawn: (" 
-                << spawnLocation.getX() << "," << spawnLocation.getY() << "," << spawnLocation.getZ() << ")";
-            plugin_->getLogger().info(msg.str());
-        }
-    }
-    
-    // Restore inventory
-    auto& inventory = pl->getInventory();
-    inventory.clear();
-    
-    // Create a vector of pointers for addItem
-    std::vector<endstone::ItemStack*> itemPointers;
-    itemPointers.reserve(data.savedInventory.size());
-    for (auto& item : data.savedInventory) {
-        itemPointers.push_back(item.get());
-    }
-    
-    // Add all items at once
-    if (!itemPointers.empty()) {
-        inventory.addItem(itemPointers);
-        
-        if (plugin_) {
-            std::ostringstream msg;
-            msg << "Restored " << itemPointers.size() << " items for player " << pl->getName();
-            plugin_->getLogger().info(msg.str());
-        }
+        if (Log::enabled(LogLevel::Debug)) traceLocation("state.fallback_spawn", pl, spawnLocation);
     }
     
+    // Restore inventory slot by slot
+    data.savedInventory.restore(pl->getInventory());
+    LOG_DEBUG("state.inventory_restored", {"player", pl->getName()}, {"items", data.savedInventory.size()});
+
     // Clear saved inventory
     data.savedInventory.clear();
+    LimboJournal::recordRestore(getId(pl));
     data.originalLocation.reset();
 }
 
 void PlayerManager::startAuthorizationTimer(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it == playerDataMap.end()) return;
-    
-    auto& data = it->second;
+    if (!find(pl)) return;
     
     // Stop any existing timers
     stopAuthorizationTimer(pl);
+    auto& data = enterLimbo(pl);
     
-    if (plugin_) {
-        std::string playerId = pl->getUniqueId().str();
-        // Create kick task
-        data.authTimerTask = plugin_->getServer().getScheduler().runTaskLater(
-            *plugin_,
-            [playerId]() {
-                if (plugin_) {
-                    auto& server = plugin_->getServer();
-                    auto* player = server.getPlayer(PlayerManager::parseUUIDFromString(playerId));
-                    if (player && !PlayerManager::isPlayerAuthenticated(player)) {
-                        player->kick(endstone::ColorFormat::Red + "Время авторизации истекло");
-                    }
-                }
-            },
-            AUTH_TIMEOUT.count() * 20 // Convert to ticks (20 ticks = 1 second)
-        );
-        
-        // Create reminder task with specific intervals
-        data.authReminderTask = plugin_->getServer().getScheduler().runTaskTimer(
-            *plugin_,
-            [playerId]() {
-                if (plugin_) {
-                    auto& server = plugin_->getServer();
-                    auto* player = server.getPlayer(PlayerManager::parseUUIDFromString(playerId));
-                    if (player && !PlayerManager::isPlayerAuthenticated(player)) {
-                        auto it = PlayerManager::playerDataMap.find(player);
-                        if (it != PlayerManager::playerDataMap.end()) {
-                            auto& data = it->second;
-                            auto now = std::chrono::steady_clock::now();
-                            auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - data.joinTime);
-                            auto timeLeft = AUTH_TIMEOUT.count() - elapsed.count();
-                            
-                            if (timeLeft > 0) {
-                                // Send reminder every 15 seconds
-                                PlayerManager::sendAuthorizationReminder(player, static_cast<int>(timeLeft));
-                            }
-                        }
-                    }
-                }
-            },
-            15 * 20, // Start checking after 15 seconds
-            15 * 20  // Check every 15 seconds
-        );
-    }
+    // Only the timeout is per player, reminders come from the shared broadcast pass
+    data.authStart = std::chrono::steady_clock::now();
+    data.authTimer = timers_.schedule(AUTH_TIMEOUT.count() * 20, getHandle(pl), TIMER_AUTH_TIMEOUT); // 20 ticks = 1 second
 }
 
 void PlayerManager::stopAuthorizationTimer(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it == playerDataMap.end()) return;
-    
-    auto& data = it->second;
-    
-    // Cancel kick task
-    if (data.authTimerTask) {
-        data.authTimerTask->cancel();
-        data.authTimerTask.reset();
-    }
+    LimboState* limbo = findLimbo(pl);
+    if (!limbo) return;
     
-    // Cancel reminder task
-    if (data.authReminderTask) {
-        data.authReminderTask->cancel();
-        data.authReminderTask.reset();
-    }
+    cancelTimer(limbo->authTimer);
 }
 
 void PlayerManager::sendAuthorizationReminder(endstone::Player* pl, int secondsLeft) {
     if (!pl) return;
-    
-    // Send chat message with instructions
-    std::ostringstream msg;
-    msg << endstone::ColorFormat::Yellow << "[Auth] У вас осталось " << secondsLeft << " секунд для авторизации!";
-    pl->sendMessage(msg.str());
-    
-    // Send instructions
-    pl->sendMessage(endstone::ColorFormat::Gold + "Используйте /register <пароль> <подтверждение> для регистрации");
-    pl->sendMessage(endstone::ColorFormat::Gold + "Или /login <пароль> для входа в существующий аккаунт");
-    
-    // Send title/subtitle for visual notification
-    if (secondsLeft <= 30) {
-        pl->sendTitle("СРОЧНО АВТОРИЗУЙТЕСЬ!", "Осталось: " + std::to_string(secondsLeft) + " секунд", 0, 60, 20);
-    } else {
-        pl->sendTitle("Требуется авторизация", "Осталось: " + std::to_string(secondsLeft) + " секунд", 0, 40, 10);
-    }
+
+    ReminderBucket bucket;
+    formatAuthReminder(bucket, secondsLeft);
+    deliverAuthReminder(pl, bucket, secondsLeft);
 }
 
 bool PlayerManager::isPlayerAuthenticated(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    return it != playerDataMap.end() && it->second.isAuthenticated;
+    return getAuthFlags(pl) & AUTH_AUTHENTICATED;
 }
 
 void PlayerManager::markPlayerAsAuthenticated(endstone::Player* pl) {
-    auto it = playerDataMap.find(pl);
-    if (it != playerDataMap.end()) {
-        it->second.isAuthenticated = true;
-    }
+    setAuthFlags(pl, AUTH_AUTHENTICATED);
 }
 
 bool PlayerManager::isCommandAllowed(const std::string& command) {
@@ -36,11 +36,26 @@ ENDSTONE_PLUGIN(/*name=*/"player_register", /*version=*/"1.4.0", /*main_class=*/
         .usages("/resetpassword <username: str>")
         .permissions("player_register.command.resetpassword");
 
+    command("resetpasswords") //
+        .description("Массово сбросить пароли по списку ников или шаблону (только для операторов).")
+        .usages("/resetpasswords <filters: message>")
+        .permissions("player_register.command.resetpasswords");
+
+    command("rotatepepper") //
+        .description("Сменить ключ перца паролей (только для операторов).")
+        .usages("/rotatepepper")
+        .permissions("player_register.command.rotatepepper");
+
     command("logout") //
         .description("Выйти из текущего аккаунта.")
         .usages("/logout")
         .permissions("player_register.command.logout");
 
+    command("authstats") //
+        .description("Показать статистику плагина регистрации (только для операторов).")
+        .usages("/authstats")
+        .permissions("player_register.command.authstats");
+
     permission("player_register.command")
         .description("Разрешить пользователям использовать все команды плагина регистрации")
         .children("player_register.command.register", true)
@@ -72,4 +87,16 @@ ENDSTONE_PLUGIN(/*name=*/"player_register", /*version=*/"1.4.0", /*main_class=*/
     permission("player_register.command.resetpassword")
         .description("Разрешить операторам сбрасывать пароли игроков")
         .default_(endstone::PermissionDefault::Operator);
+
+    permission("player_register.command.resetpasswords")
+        .description("Разрешить операторам массово сбрасывать пароли")
+        .default_(endstone::PermissionDefault::Operator);
+
+    permission("player_register.command.rotatepepper")
+        .description("Разрешить операторам менять ключ перца паролей")
+        .default_(endstone::PermissionDefault::Operator);
+
+    permission("player_register.command.authstats")
+        .description("Разрешить операторам просматривать статистику плагина")
+        .default_(endstone::PermissionDefault::Operator);
 }
@@ -1,6 +1,8 @@
 // Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
 
 #include "player_register_listener.h"
+#include "log.h"
+#include "messages.h"
 #include "player_manager.h"
 #include <endstone/endstone.hpp>
 
@@ -12,18 +14,18 @@ void PlayerRegisterListener::onServerLoad(endstone::ServerLoadEvent &event)
 void PlayerRegisterListener::onPlayerJoin(endstone::PlayerJoinEvent &event)
 {
     auto& player = event.getPlayer();
-    plugin_.getLogger().info("Player joined: {}", player.getName());
+    LOG_INFO("player.join", {"player", player.getName()});
     
-    // Start authorization process for the player
-    PlayerRegister::PlayerManager::startAuthorizationProcess(&player);
+    // Load the record and put the player into limbo, see PlayerManager's join stages
+    PlayerRegister::PlayerManager::loadPlayer(&player);
 }
 
 void PlayerRegisterListener::onPlayerQuit(endstone::PlayerQuitEvent &event)
 {
     auto& player = event.getPlayer();
-    plugin_.getLogger().info("Player quit: {}", player.getName());
+    LOG_INFO("player.quit", {"player", player.getName()});
     
-    // Clean up player data
+    // Issue a resume ticket and clean up player data, see PlayerManager's quit stages
     PlayerRegister::PlayerManager::unloadPlayer(&player);
 }
 
@@ -35,8 +37,7 @@ void PlayerRegisterListener::onPlayerChat(endstone::PlayerChatEvent &event)
     if (!PlayerRegister::PlayerManager::isPlayerAuthorized(&player)) {
         // Player is not authorized, cancel the chat event
         event.setCancelled(true);
-        player.sendMessage(endstone::ColorFormat::Red + "Вы должны авторизоваться, чтобы писать в чат!");
-        player.sendMessage(endstone::ColorFormat::Gold + "Используйте /register <пароль> <подтверждение> или /login <пароль>");
+        PlayerRegister::Messages::send(player, PlayerRegister::MsgId::ChatBlocked);
     }
 }
 
@@ -60,8 +61,7 @@ void PlayerRegisterListener::onPlayerCommand(endstone::PlayerCommandEvent &event
         if (!PlayerRegister::PlayerManager::isCommandAllowed(command_name)) {
             // Command is not allowed, cancel the event
             event.setCancelled(true);
-            player.sendMessage(endstone::ColorFormat::Red + "Вы должны авторизоваться, чтобы использовать команды!");
-            player.sendMessage(endstone::ColorFormat::Gold + "Используйте /register <пароль> <подтверждение> или /login <пароль>");
+            PlayerRegister::Messages::send(player, PlayerRegister::MsgId::CommandBlocked);
         }
     }
 }
\ No newline at end of file
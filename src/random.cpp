@@ -0,0 +1,142 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "random.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+namespace PlayerRegister {
+
+namespace {
+
+constexpr size_t BLOCKS_PER_REFILL = 4;
+constexpr size_t KEY_BYTES = 32;
+
+inline uint32_t rotl32(uint32_t x, int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+inline void quarterRound(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d) {
+    a += b; d ^= a; d = rotl32(d, 16);
+    c += d; b ^= c; b = rotl32(b, 12);
+    a += b; d ^= a; d = rotl32(d, 8);
+    c += d; b ^= c; b = rotl32(b, 7);
+}
+
+} // namespace
+
+struct Random::State {
+    uint32_t key[8];
+    uint32_t nonce[3];
+    uint32_t counter = 0;
+    uint8_t buffer[64 * BLOCKS_PER_REFILL];
+    size_t pos = sizeof(buffer);
+};
+
+void Random::chachaBlock(const uint32_t key[8], uint32_t counter, const uint32_t nonce[3], uint8_t out[64]) {
+    const uint32_t input[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+        key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+        counter, nonce[0], nonce[1], nonce[2]
+    };
+
+    uint32_t x[16];
+    std::memcpy(x, input, sizeof(x));
+    for (int i = 0; i < 10; i++) {
+        quarterRound(x[0], x[4], x[8], x[12]);
+        quarterRound(x[1], x[5], x[9], x[13]);
+        quarterRound(x[2], x[6], x[10], x[14]);
+        quarterRound(x[3], x[7], x[11], x[15]);
+        quarterRound(x[0], x[5], x[10], x[15]);
+        quarterRound(x[1], x[6], x[11], x[12]);
+        quarterRound(x[2], x[7], x[8], x[13]);
+        quarterRound(x[3], x[4], x[9], x[14]);
+    }
+
+    for (int i = 0; i < 16; i++) {
+        uint32_t v = x[i] + input[i];
+        out[i * 4 + 0] = static_cast<uint8_t>(v);
+        out[i * 4 + 1] = static_cast<uint8_t>(v >> 8);
+        out[i * 4 + 2] = static_cast<uint8_t>(v >> 16);
+        out[i * 4 + 3] = static_cast<uint8_t>(v >> 24);
+    }
+}
+
+Random::State& Random::state() {
+    thread_local State s = []() {
+        State seeded;
+        std::random_device rd;
+        for (auto& word : seeded.key) word = rd();
+        for (auto& word : seeded.nonce) word = rd();
+        return seeded;
+    }();
+    return s;
+}
+
+void Random::refill(State& s) {
+    for (size_t i = 0; i < BLOCKS_PER_REFILL; i++) {
+        chachaBlock(s.key, s.counter++, s.nonce, s.buffer + i * 64);
+    }
+    if (s.counter == 0) {
+        s.nonce[0]++;
+    }
+
+    // Fast key erasure: the first 32 bytes become the next key and are never handed out
+    for (int i = 0; i < 8; i++) {
+        s.key[i] = uint32_t(s.buffer[i * 4]) | (uint32_t(s.buffer[i * 4 + 1]) << 8) |
+                   (uint32_t(s.buffer[i * 4 + 2]) << 16) | (uint32_t(s.buffer[i * 4 + 3]) << 24);
+    }
+    std::memset(s.buffer, 0, KEY_BYTES);
+    s.pos = KEY_BYTES;
+}
+
+void Random::fill(uint8_t* out, size_t length) {
+    State& s = state();
+    while (length > 0) {
+        if (s.pos == sizeof(s.buffer)) {
+            refill(s);
+        }
+        size_t take = std::min(length, sizeof(s.buffer) - s.pos);
+        std::memcpy(out, s.buffer + s.pos, take);
+        // Served bytes are wiped so they can't be read back from this thread's buffer
+        std::memset(s.buffer + s.pos, 0, take);
+        s.pos += take;
+        out += take;
+        length -= take;
+    }
+}
+
+uint64_t Random::next() {
+    uint8_t bytes[8];
+    fill(bytes, sizeof(bytes));
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v = (v << 8) | bytes[i];
+    }
+    return v;
+}
+
+uint64_t Random::uniform(uint64_t bound) {
+    if (bound <= 1) {
+        return 0;
+    }
+    // Reject the top partial range so every residue is equally likely
+    const uint64_t limit = UINT64_MAX - UINT64_MAX % bound;
+    uint64_t v;
+    do {
+        v = next();
+    } while (v >= limit);
+    return v % bound;
+}
+
+std::string Random::digits(size_t count) {
+    std::string out;
+    out.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        out.push_back(static_cast<char>('0' + (i == 0 ? 1 + uniform(9) : uniform(10))));
+    }
+    return out;
+}
+
+} // namespace PlayerRegister
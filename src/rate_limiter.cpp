@@ -0,0 +1,131 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "rate_limiter.h"
+
+#include "config.h"
+#include "messages.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace PlayerRegister {
+
+std::unique_ptr<RateLimiter::Slot[]> RateLimiter::table_;
+uint64_t RateLimiter::burstMilli_ = 5000;
+uint64_t RateLimiter::refillPerSecondMilli_ = 50;
+std::chrono::steady_clock::time_point RateLimiter::epoch_;
+std::atomic<uint64_t> RateLimiter::rejected_{0};
+std::atomic<uint64_t> RateLimiter::overflows_{0};
+
+void RateLimiter::init() {
+    const auto& config = Config::getInstance();
+    burstMilli_ = std::clamp<uint64_t>(static_cast<uint64_t>(std::max(config.login_attempts_burst, 1)) * 1000, 1000, TOKEN_MASK);
+    refillPerSecondMilli_ = std::max<uint64_t>(static_cast<uint64_t>(std::max(config.login_attempts_per_minute, 1)) * 1000 / 60, 1);
+    epoch_ = std::chrono::steady_clock::now();
+    table_ = std::make_unique<Slot[]>(CAPACITY);
+    // Empty slots hold a full bucket, so a reader that sees a freshly claimed
+    // key before its state was reset still starts from a full bucket
+    for (size_t i = 0; i < CAPACITY; i++) {
+        table_[i].state.store(burstMilli_, std::memory_order_relaxed);
+    }
+}
+
+uint64_t RateLimiter::nowMs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - epoch_).count());
+}
+
+uint64_t RateLimiter::hashKey(char kind, std::string_view value) {
+    // FNV-1a, case-insensitive so "Steve" and "steve" share a bucket
+    uint64_t h = 0xcbf29ce484222325ULL;
+    h = (h ^ static_cast<uint8_t>(kind)) * 0x100000001b3ULL;
+    for (char c : value) {
+        h = (h ^ static_cast<uint8_t>(std::tolower(static_cast<unsigned char>(c)))) * 0x100000001b3ULL;
+    }
+    return h | 1; // 0 marks an empty slot, the index comes from the high bits
+}
+
+size_t RateLimiter::homeSlot(uint64_t key) {
+    return static_cast<size_t>(key >> 32) & (CAPACITY - 1);
+}
+
+bool RateLimiter::consume(uint64_t key, uint64_t now) {
+    const uint64_t fullAfterMs = burstMilli_ * 1000 / refillPerSecondMilli_;
+    const uint64_t freshState = (now << TOKEN_BITS) | burstMilli_;
+
+    for (size_t probe = 0; probe < MAX_PROBES; probe++) {
+        Slot& slot = table_[(homeSlot(key) + probe) & (CAPACITY - 1)];
+        uint64_t current = slot.key.load(std::memory_order_acquire);
+
+        if (current != key) {
+            uint64_t state = slot.state.load(std::memory_order_acquire);
+            uint64_t last = state >> TOKEN_BITS;
+            bool idle = current != 0 && now >= last && now - last >= fullAfterMs;
+            if (current != 0 && !idle) continue;
+            // Claim an empty slot, or take over one whose bucket would be full
+            // anyway. The key is published first; the state we judged is then
+            // reset, unless someone already consumed from it, which a full
+            // bucket allows either way.
+            if (slot.key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                slot.state.compare_exchange_strong(state, freshState, std::memory_order_acq_rel);
+            } else if (current != key) {
+                continue;
+            }
+        }
+
+        uint64_t state = slot.state.load(std::memory_order_relaxed);
+        while (true) {
+            uint64_t last = state >> TOKEN_BITS;
+            uint64_t tokens = state & TOKEN_MASK;
+            if (now > last) {
+                // Only advance the clock by the time actually converted into tokens,
+                // otherwise rapid polling would truncate the refill to zero forever
+                uint64_t gained = (now - last) * refillPerSecondMilli_ / 1000;
+                if (tokens + gained >= burstMilli_) {
+                    tokens = burstMilli_;
+                    last = now;
+                } else {
+                    tokens += gained;
+                    last += gained * 1000 / refillPerSecondMilli_;
+                }
+            }
+            if (tokens < 1000) {
+                return false;
+            }
+            uint64_t next = (last << TOKEN_BITS) | (tokens - 1000);
+            if (slot.state.compare_exchange_weak(state, next, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    // Table neighbourhood is full of active buckets; fail open rather than lock out real players
+    overflows_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool RateLimiter::allowLogin(endstone::Player& pl) {
+    if (!table_) return true;
+
+    const uint64_t now = nowMs();
+    bool allowed = consume(hashKey('i', pl.getAddress().getHostname()), now) &&
+                   consume(hashKey('n', pl.getName()), now);
+    if (!allowed) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return allowed;
+}
+
+uint64_t RateLimiter::getRejected() {
+    return rejected_.load(std::memory_order_relaxed);
+}
+
+uint64_t RateLimiter::getOverflows() {
+    return overflows_.load(std::memory_order_relaxed);
+}
+
+void RateLimiter::describeStats(std::vector<std::string>& lines) {
+    lines.push_back(msg(MsgId::StatsRateLimiter, getRejected(), getOverflows()));
+}
+
+} // namespace PlayerRegister
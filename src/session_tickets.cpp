@@ -0,0 +1,198 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "session_tickets.h"
+
+#include "config.h"
+#include "credential.h"
+#include "hmac.h"
+#include "messages.h"
+#include "random.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace PlayerRegister {
+
+std::vector<SessionTickets::Ticket> SessionTickets::table_;
+KeyedHasher SessionTickets::hasher_;
+std::unordered_set<std::string> SessionTickets::revoked_;
+
+namespace {
+
+std::array<uint8_t, 16> uuidBytes(endstone::Player* pl) {
+    std::array<uint8_t, 16> bytes;
+    auto uuid = pl->getUniqueId();
+    std::memcpy(bytes.data(), uuid.data, bytes.size());
+    return bytes;
+}
+
+} // namespace
+
+void SessionTickets::init() {
+    // Round the capacity up to a power of two so slots can be masked
+    size_t capacity = 16;
+    while (capacity < static_cast<size_t>(Config::getInstance().session_ticket_capacity)) {
+        capacity <<= 1;
+    }
+    table_.assign(capacity, Ticket{});
+    std::array<uint8_t, 32> key;
+    Random::fill(key.data(), key.size());
+    hasher_ = KeyedHasher(key.data(), key.size());
+    key.fill(0);
+    revoked_.clear();
+}
+
+void SessionTickets::clear() {
+    table_.clear();
+    revoked_.clear();
+    hasher_ = KeyedHasher();
+}
+
+int64_t SessionTickets::now() {
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+size_t SessionTickets::slotFor(const std::array<uint8_t, 16>& uuid) {
+    // UUIDs are already random, the low bytes spread well enough
+    uint64_t h;
+    std::memcpy(&h, uuid.data() + 8, sizeof(h));
+    return static_cast<size_t>(h ^ (h >> 29)) & (table_.size() - 1);
+}
+
+std::array<uint8_t, 8> SessionTickets::accountKey(const std::string& account) {
+    auto mac = hasher_.mac(reinterpret_cast<const uint8_t*>(account.data()), account.size());
+    std::array<uint8_t, 8> key;
+    std::memcpy(key.data(), mac.data(), key.size());
+    return key;
+}
+
+std::array<uint8_t, 16> SessionTickets::computeTag(const std::array<uint8_t, 16>& uuid, const std::string& ip, int64_t expiresAt) {
+    uint8_t message[16 + 8 + 64];
+    size_t length = 0;
+    std::memcpy(message, uuid.data(), uuid.size());
+    length += uuid.size();
+    for (int i = 0; i < 8; i++) {
+        message[length++] = static_cast<uint8_t>(static_cast<uint64_t>(expiresAt) >> (8 * i));
+    }
+    size_t ipLength = std::min(ip.size(), sizeof(message) - length);
+    std::memcpy(message + length, ip.data(), ipLength);
+    length += ipLength;
+
+    auto mac = hasher_.mac(message, length);
+    std::array<uint8_t, 16> tag;
+    std::memcpy(tag.data(), mac.data(), tag.size());
+    return tag;
+}
+
+void SessionTickets::issue(endstone::Player* pl, const std::string& account) {
+    const int ttl = Config::getInstance().session_resume_seconds;
+    if (table_.empty() || ttl <= 0) return;
+    if (revoked_.erase(pl->getUniqueId().str()) > 0) return;
+
+    const auto uuid = uuidBytes(pl);
+    const int64_t current = now();
+
+    // Reuse this player's slot, else the first empty or expired one, else the one expiring soonest
+    size_t mask = table_.size() - 1;
+    size_t start = slotFor(uuid);
+    size_t target = start;
+    for (size_t i = 0; i < MAX_PROBES; i++) {
+        size_t index = (start + i) & mask;
+        const Ticket& slot = table_[index];
+        if (slot.expiresAt != 0 && slot.uuid == uuid) {
+            target = index;
+            break;
+        }
+        if (slot.expiresAt <= current) {
+            target = index;
+            break;
+        }
+        if (slot.expiresAt < table_[target].expiresAt) {
+            target = index;
+        }
+    }
+
+    Ticket& ticket = table_[target];
+    ticket.uuid = uuid;
+    ticket.expiresAt = current + ttl;
+    ticket.tag = computeTag(uuid, pl->getAddress().getHostname(), ticket.expiresAt);
+    ticket.account = accountKey(account);
+}
+
+bool SessionTickets::redeem(endstone::Player* pl) {
+    if (table_.empty()) return false;
+
+    const auto uuid = uuidBytes(pl);
+    size_t mask = table_.size() - 1;
+    size_t start = slotFor(uuid);
+    for (size_t i = 0; i < MAX_PROBES; i++) {
+        Ticket& ticket = table_[(start + i) & mask];
+        if (ticket.expiresAt == 0 || ticket.uuid != uuid) continue;
+
+        // Tickets are single-use whether or not they verify
+        Ticket found = ticket;
+        ticket = Ticket{};
+
+        if (found.expiresAt <= now()) return false;
+
+        auto expected = computeTag(uuid, pl->getAddress().getHostname(), found.expiresAt);
+        std::array<uint8_t, 32> a{};
+        std::array<uint8_t, 32> b{};
+        std::memcpy(a.data(), expected.data(), expected.size());
+        std::memcpy(b.data(), found.tag.data(), found.tag.size());
+        return constantTimeEqual(a, b);
+    }
+    return false;
+}
+
+void SessionTickets::revoke(endstone::Player* pl) {
+    revoked_.insert(pl->getUniqueId().str());
+    if (table_.empty()) return;
+
+    const auto uuid = uuidBytes(pl);
+    size_t mask = table_.size() - 1;
+    size_t start = slotFor(uuid);
+    for (size_t i = 0; i < MAX_PROBES; i++) {
+        Ticket& ticket = table_[(start + i) & mask];
+        if (ticket.expiresAt != 0 && ticket.uuid == uuid) {
+            ticket = Ticket{};
+        }
+    }
+}
+
+size_t SessionTickets::revokeAccounts(const std::unordered_set<std::string>& accounts) {
+    if (table_.empty() || accounts.empty()) return 0;
+
+    // Tickets are found by UUID, so an account lookup has to scan the table
+    std::vector<std::array<uint8_t, 8>> keys;
+    keys.reserve(accounts.size());
+    for (const auto& account : accounts) {
+        keys.push_back(accountKey(account));
+    }
+
+    size_t revoked = 0;
+    for (auto& ticket : table_) {
+        if (ticket.expiresAt == 0) continue;
+        if (std::find(keys.begin(), keys.end(), ticket.account) != keys.end()) {
+            ticket = Ticket{};
+            revoked++;
+        }
+    }
+    return revoked;
+}
+
+size_t SessionTickets::size() {
+    const int64_t current = now();
+    size_t count = 0;
+    for (const auto& ticket : table_) {
+        if (ticket.expiresAt > current) count++;
+    }
+    return count;
+}
+
+void SessionTickets::describeStats(std::vector<std::string>& lines) {
+    lines.push_back(msg(MsgId::StatsTickets, size()));
+}
+
+} // namespace PlayerRegister
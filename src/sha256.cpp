@@ -2,12 +2,64 @@
 
 #include "sha256.h"
 
+#include "hex.h"
+#include "hmac.h"
+
 #include <cstring>
-#include <iomanip>
-#include <sstream>
 #include <algorithm>
 
-SHA256::SHA256() : m_blocklen(0), m_bitlen(0) {
+// Known-answer tests, checked by every build
+namespace {
+
+constexpr bool matchesHex(std::string_view input, std::string_view expected,
+                          SHA256::Variant variant = SHA256::Variant::Legacy) {
+    std::array<uint8_t, 32> digest{};
+    return hex::decode(expected, digest.data(), digest.size()) && SHA256::compileTimeHash(input, variant) == digest;
+}
+
+constexpr bool hmacMatchesHex(std::string_view key, std::string_view data, std::string_view expected) {
+    std::array<uint8_t, 32> mac{};
+    return hex::decode(expected, mac.data(), mac.size()) && compileTimeHmacSha256(key, data) == mac;
+}
+
+constexpr auto STANDARD = SHA256::Variant::Standard;
+
+static_assert(matchesHex("", "3ed5d7ba8560755fc95da4f3c716f2238609e34bb021bb26d93d52bf35293de5"));
+static_assert(matchesHex("abc", "65b26326bf481d7b00b7af2c5f0076644e810d78ce85214d7c0ab7725f150260"));
+static_assert(matchesHex("The quick brown fox jumps over the lazy dog",
+                         "87e15931abbcd3f0e1d7853cfe946d3125a2d0a1a81105df1afcf9c8c5f21702"));
+// 55 and 56 bytes straddle the point where padding spills into a second block
+static_assert(matchesHex("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+                         "bc7d8efd6315b901f5afb046b947ee10c73e9d67fdd27d5c318e46208a95e0e6"));
+static_assert(matchesHex("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+                         "ce11e20f4e0a9758ee020913813e57f98c37dcc5b654b8894f85a0aee02efb22"));
+static_assert(matchesHex("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+                         "2e9e8c3e0081319130e6165a3d4ad1191e8c46ccd6775b7c5d714a3c31eb1207"));
+
+// FIPS 180-4 examples for the standard variant
+static_assert(matchesHex("", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", STANDARD));
+static_assert(matchesHex("abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", STANDARD));
+static_assert(matchesHex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+                         "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", STANDARD));
+
+// RFC 4231 test cases 2 and 6, the latter with a key longer than a block
+static_assert(hmacMatchesHex("Jefe", "what do ya want for nothing?",
+                             "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"));
+static_assert(hmacMatchesHex(std::string_view("\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa"
+                                              "\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa"
+                                              "\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa"
+                                              "\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa"
+                                              "\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa"
+                                              "\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa"
+                                              "\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa"
+                                              "\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa"
+                                              "\xaa\xaa\xaa", 131),
+                             "Test Using Larger Than Block-Size Key - Hash Key First",
+                             "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"));
+
+} // namespace
+
+SHA256::SHA256(Variant variant) : m_blocklen(0), m_bitlen(0), m_variant(variant) {
     m_state[0] = 0x6a09e667;
     m_state[1] = 0xbb67ae85;
     m_state[2] = 0x3c6ef372;
@@ -43,17 +95,17 @@ std::array<uint8_t, 32> SHA256::digest() {
 }
 
 std::string SHA256::toString(const std::array<uint8_t, 32> & digest) {
-    std::stringstream ss;
-    for (uint8_t byte : digest) {
-        ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
-    }
-    return ss.str();
+    return hex::encode(digest.data(), digest.size());
 }
 
 std::string SHA256::digest_str(const std::string &data) {
+    return toString(hash(data));
+}
+
+std::array<uint8_t, 32> SHA256::hash(const std::string &data) {
     SHA256 sha;
     sha.update(data);
-    return toString(sha.digest());
+    return sha.digest();
 }
 
 uint32_t SHA256::rotr(uint32_t x, uint32_t n) {
@@ -76,6 +128,14 @@ uint32_t SHA256::sig1(uint32_t x) {
     return rotr(x, 17) ^ rotr(x, 19) ^ (x >> 10);
 }
 
+uint32_t SHA256::ep0(uint32_t x) {
+    return rotr(x, 2) ^ rotr(x, 13) ^ rotr(x, 22);
+}
+
+uint32_t SHA256::ep1(uint32_t x) {
+    return rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25);
+}
+
 void SHA256::transform() {
     uint32_t w[64];
     uint32_t t1, t2;
@@ -97,9 +157,10 @@ void SHA256::transform() {
     uint32_t g = m_state[6];
     uint32_t h = m_state[7];
 
+    const bool standard = m_variant == Variant::Standard;
     for (int i = 0; i < 64; i++) {
-        t1 = h + sig1(e) + choose(e, f, g) + K[i] + w[i];
-        t2 = sig0(a) + majority(a, b, c);
+        t1 = h + (standard ? ep1(e) : sig1(e)) + choose(e, f, g) + K[i] + w[i];
+        t2 = (standard ? ep0(a) : sig0(a)) + majority(a, b, c);
         h = g;
         g = f;
         f = e;
@@ -121,7 +182,8 @@ void SHA256::transform() {
 }
 
 void SHA256::pad() {
-    uint64_t i = m_blocklen;
+    // Standard encodes the message length; Legacy the length after padding
+    const uint64_t messageBits = m_bitlen + m_blocklen * 8;
     uint8_t temp = 0x80;
 
     update(&temp, 1);
@@ -131,7 +193,7 @@ void SHA256::pad() {
         update(&temp, 1);
     }
 
-    uint64_t bitlen = m_bitlen + m_blocklen * 8;
+    uint64_t bitlen = m_variant == Variant::Standard ? messageBits : m_bitlen + m_blocklen * 8;
     for (int i = 7; i >= 0; i--) {
         temp = static_cast<uint8_t>((bitlen >> (i * 8)) & 0xFF);
         update(&temp, 1);
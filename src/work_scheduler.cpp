@@ -0,0 +1,134 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "work_scheduler.h"
+
+#include "config.h"
+#include "messages.h"
+
+#include <algorithm>
+
+namespace PlayerRegister {
+
+std::shared_ptr<endstone::Task> WorkScheduler::task_;
+std::vector<void (*)()> WorkScheduler::hooks_;
+std::mutex WorkScheduler::mutex_;
+std::array<std::vector<WorkScheduler::Item>, static_cast<size_t>(WorkQueue::Count)> WorkScheduler::incoming_;
+std::array<WorkScheduler::Queue, static_cast<size_t>(WorkQueue::Count)> WorkScheduler::queues_;
+uint64_t WorkScheduler::lastTickUs_ = 0;
+uint64_t WorkScheduler::maxTickUs_ = 0;
+uint64_t WorkScheduler::carriedTicks_ = 0;
+
+void WorkScheduler::start(endstone::Plugin& plugin) {
+    stop();
+    task_ = plugin.getServer().getScheduler().runTaskTimer(plugin, []() { tick(); }, 1, 1);
+}
+
+void WorkScheduler::stop() {
+    if (task_) {
+        task_->cancel();
+        task_.reset();
+    }
+    hooks_.clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& incoming : incoming_) incoming.clear();
+    for (auto& queue : queues_) queue = Queue{};
+}
+
+void WorkScheduler::addTickHook(void (*hook)()) {
+    hooks_.push_back(hook);
+}
+
+void WorkScheduler::post(WorkQueue queue, Work work) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    incoming_[static_cast<size_t>(queue)].push_back(Item{std::move(work), std::chrono::steady_clock::now()});
+}
+
+void WorkScheduler::tick() {
+    auto start = std::chrono::steady_clock::now();
+
+    for (auto* hook : hooks_) {
+        hook();
+    }
+
+    // Move posted work into the server-side queues under one short lock
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < incoming_.size(); i++) {
+            auto& ready = queues_[i].ready;
+            for (auto& item : incoming_[i]) ready.push_back(std::move(item));
+            incoming_[i].clear();
+        }
+    }
+
+    // Hooks count against the budget too; at least one item runs per tick so nothing starves forever
+    auto budget = std::chrono::microseconds(std::max(Config::getInstance().tick_budget_us, 0));
+    bool ranAny = false;
+    bool carried = false;
+    for (auto& queue : queues_) {
+        while (!queue.ready.empty()) {
+            auto now = std::chrono::steady_clock::now();
+            if (ranAny && now - start >= budget) {
+                carried = true;
+                break;
+            }
+
+            Item item = std::move(queue.ready.front());
+            queue.ready.pop_front();
+            auto latency = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(now - item.posted).count());
+            queue.completed++;
+            queue.totalLatencyUs += latency;
+            queue.maxLatencyUs = std::max(queue.maxLatencyUs, latency);
+
+            item.work();
+            ranAny = true;
+        }
+        if (carried) break;
+    }
+
+    if (carried) carriedTicks_++;
+    lastTickUs_ = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    maxTickUs_ = std::max(maxTickUs_, lastTickUs_);
+}
+
+WorkScheduler::QueueStats WorkScheduler::getStats(WorkQueue queue) {
+    const Queue& q = queues_[static_cast<size_t>(queue)];
+    QueueStats stats;
+    stats.completed = q.completed;
+    stats.avgLatencyUs = q.completed ? q.totalLatencyUs / q.completed : 0;
+    stats.maxLatencyUs = q.maxLatencyUs;
+    stats.pending = q.ready.size();
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.pending += incoming_[static_cast<size_t>(queue)].size();
+    return stats;
+}
+
+uint64_t WorkScheduler::getLastTickUs() {
+    return lastTickUs_;
+}
+
+uint64_t WorkScheduler::getMaxTickUs() {
+    return maxTickUs_;
+}
+
+uint64_t WorkScheduler::getCarriedTicks() {
+    return carriedTicks_;
+}
+
+void WorkScheduler::describeStats(std::vector<std::string>& lines) {
+    static const MsgId NAMES[] = {MsgId::QueueAuth, MsgId::QueuePersistence, MsgId::QueueReminders,
+                                  MsgId::QueueHousekeeping};
+    static_assert(std::size(NAMES) == static_cast<size_t>(WorkQueue::Count));
+
+    lines.push_back(msg(MsgId::StatsSchedulerTick, getLastTickUs(), getMaxTickUs(), getCarriedTicks()));
+    for (size_t i = 0; i < std::size(NAMES); i++) {
+        auto queue = getStats(static_cast<WorkQueue>(i));
+        // The queue name is copied, the next msg() call reuses the buffer
+        std::string name = msg(NAMES[i]);
+        lines.push_back(
+            msg(MsgId::StatsQueue, name, queue.pending, queue.completed, queue.avgLatencyUs, queue.maxLatencyUs));
+    }
+}
+
+} // namespace PlayerRegister
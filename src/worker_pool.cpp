@@ -0,0 +1,114 @@
+// Copyright (c) 2024, The Endstone Project. (https://endstone.dev) All Rights Reserved.
+
+#include "worker_pool.h"
+
+#include <algorithm>
+
+namespace PlayerRegister {
+
+WorkerPool::WorkerPool(std::string name, size_t threads, size_t capacity)
+    : name_(std::move(name))
+    , capacity_(std::max<size_t>(capacity, 1))
+{
+    threads = std::max<size_t>(threads, 1);
+    threads_.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+        threads_.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    shutdown();
+}
+
+bool WorkerPool::submit(Job job) {
+    return enqueue(std::move(job), true);
+}
+
+bool WorkerPool::submitUnbounded(Job job) {
+    return enqueue(std::move(job), false);
+}
+
+bool WorkerPool::enqueue(Job job, bool bounded) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_ || (bounded && queue_.size() >= capacity_)) {
+            rejected_++;
+            return false;
+        }
+        queue_.push_back({std::move(job), std::chrono::steady_clock::now()});
+        submitted_++;
+    }
+    cv_.notify_one();
+    return true;
+}
+
+void WorkerPool::shutdown(bool drain) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) return;
+        stopping_ = true;
+        if (!drain) {
+            queue_.clear();
+        }
+    }
+    cv_.notify_all();
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+}
+
+WorkerPool::Stats WorkerPool::getStats() const {
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats.threads = threads_.size();
+        stats.queued = queue_.size();
+    }
+    stats.capacity = capacity_;
+    stats.submitted = submitted_;
+    stats.rejected = rejected_;
+    stats.completed = completed_;
+    if (stats.completed > 0) {
+        stats.avgWaitUs = totalWaitUs_ / stats.completed;
+        stats.avgRunUs = totalRunUs_ / stats.completed;
+    }
+    stats.maxLatencyUs = maxLatencyUs_;
+    return stats;
+}
+
+void WorkerPool::workerLoop() {
+    using namespace std::chrono;
+
+    while (true) {
+        Entry entry;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            // A draining shutdown leaves the queue to be worked off first
+            if (queue_.empty()) return;
+            entry = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        auto started = steady_clock::now();
+        entry.job();
+        auto finished = steady_clock::now();
+
+        auto waitUs = static_cast<uint64_t>(duration_cast<microseconds>(started - entry.enqueued).count());
+        auto runUs = static_cast<uint64_t>(duration_cast<microseconds>(finished - started).count());
+        totalWaitUs_ += waitUs;
+        totalRunUs_ += runUs;
+        completed_++;
+
+        uint64_t latency = waitUs + runUs;
+        uint64_t seen = maxLatencyUs_;
+        while (latency > seen && !maxLatencyUs_.compare_exchange_weak(seen, latency)) {
+        }
+    }
+}
+
+} // namespace PlayerRegister